@@ -12,18 +12,65 @@ TARGET = RandomAggreagationLargeGraph
 CONFIG   += console
 CONFIG   += c++11
 CONFIG   -= app_bundle
+CONFIG   += thread
 
 TEMPLATE = app
 
 
 SOURCES += main.cpp \
     vertex.cpp \
-    edge.cpp \
-    graph.cpp
+    edgetable.cpp \
+    graph.cpp \
+    csrgraph.cpp \
+    activeset.cpp \
+    unionfind.cpp \
+    aliastable.cpp \
+    neighboursampler.cpp \
+    fenwicktree.cpp \
+    bucketqueue.cpp \
+    indexedheap.cpp \
+    neighbourweightheap.cpp \
+    neighbourdegreeview.cpp \
+    randomstream.cpp \
+    trianglesupport.cpp \
+    sortedintersection.cpp \
+    parallelrange.cpp \
+    graphstats.cpp \
+    binarygraphfile.cpp \
+    edgelistparser.cpp \
+    gmlreader.cpp \
+    decompressdevice.cpp
 
 HEADERS += \
     vertex.h \
-    edge.h \
-    graph.h
+    edgetable.h \
+    graph.h \
+    csrgraph.h \
+    activeset.h \
+    unionfind.h \
+    aliastable.h \
+    neighboursampler.h \
+    fenwicktree.h \
+    bucketqueue.h \
+    indexedheap.h \
+    neighbourweightheap.h \
+    neighbourdegreeview.h \
+    randomstream.h \
+    trianglesupport.h \
+    sortedintersection.h \
+    parallelrange.h \
+    graphstats.h \
+    binarygraphfile.h \
+    edgelistparser.h \
+    gmlreader.h \
+    decompressdevice.h
 
 INCLUDEPATH += "C:\Boost\boost_1_56_0"
+
+LIBS += -lz
+
+# zstd input is optional, build with: qmake CONFIG+=zstd
+zstd {
+    DEFINES += RANAGG_HAVE_ZSTD
+    LIBS += -lzstd
+}
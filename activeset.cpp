@@ -0,0 +1,60 @@
+#include "activeset.h"
+#include "vertex.h"
+
+const quint32 ActiveSet::NotActive;
+
+/** Every vertex of the list starts active
+ * @brief ActiveSet::ActiveSet
+ * @param vertex
+ */
+ActiveSet::ActiveSet(const QList<Vertex*> &vertex)
+{
+    quint32 range = 0;
+    for (int i = 0; i < vertex.size(); i++)
+        range = qMax(range, vertex.at(i)->getIndex() + 1);
+    position.fill(NotActive, range);
+    member.reserve(vertex.size());
+    for (int i = 0; i < vertex.size(); i++)
+    {
+        Vertex * v = vertex.at(i);
+        position[v->getIndex()] = member.size();
+        member.append(v);
+    }
+}
+
+bool ActiveSet::empty() const
+{
+    return member.isEmpty();
+}
+
+quint32 ActiveSet::size() const
+{
+    return member.size();
+}
+
+Vertex *ActiveSet::at(const quint32 &i) const
+{
+    return member.at(i);
+}
+
+bool ActiveSet::contains(Vertex *v) const
+{
+    quint32 id = v->getIndex();
+    return id < (quint32) position.size() && position.at(id) != NotActive;
+}
+
+/** Remove a vertex in O(1), nothing happens if it is not active
+ * @brief ActiveSet::remove
+ * @param v
+ */
+void ActiveSet::remove(Vertex *v)
+{
+    if (!contains(v))
+        return;
+    quint32 slot = position[v->getIndex()];
+    Vertex * last = member.last();
+    member[slot] = last;
+    position[last->getIndex()] = slot;
+    member.removeLast();
+    position[v->getIndex()] = NotActive;
+}
@@ -0,0 +1,33 @@
+#ifndef ACTIVESET_H
+#define ACTIVESET_H
+
+#include <QtGlobal>
+#include <QList>
+#include <QVector>
+
+class Vertex;
+
+/** Set of the vertices still playing in an aggregation
+ * member holds the active vertices densely, position[v] is the slot of the
+ * vertex with index v so a random pick and a removal are both O(1).
+ * Removing swaps the last member into the freed slot.
+ */
+class ActiveSet
+{
+public:
+    ActiveSet(const QList<Vertex*> &vertex);
+
+    bool empty() const;
+    quint32 size() const;
+    Vertex * at(const quint32 &i) const;
+    bool contains(Vertex * v) const;
+    void remove(Vertex * v);
+
+private:
+    static const quint32 NotActive = 0xFFFFFFFF;
+
+    QVector<Vertex*> member;
+    QVector<quint32> position;
+};
+
+#endif // ACTIVESET_H
@@ -0,0 +1,80 @@
+#include "aliastable.h"
+
+#include <QDebug>
+
+AliasTable::AliasTable()
+{
+}
+
+/** Vose's construction, columns with zero weight are never drawn
+ * @brief AliasTable::build
+ * @param weight
+ */
+void AliasTable::build(const QVector<quint64> &weight)
+{
+    clear();
+    quint32 n = weight.size();
+    double total = 0;
+    for (quint32 i = 0; i < n; i++)
+        total += weight[i];
+    if (n == 0 || total <= 0)
+    {
+        qDebug() << "Alias Table: No Positive Weight!";
+        return;
+    }
+    probability.resize(n);
+    alias.resize(n);
+    QVector<quint32> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (quint32 i = 0; i < n; i++)
+    {
+        probability[i] = weight[i] * n / total;
+        alias[i] = i;
+        if (probability[i] < 1.0)
+            small.append(i);
+        else
+            large.append(i);
+    }
+    while (!small.isEmpty() && !large.isEmpty())
+    {
+        quint32 s = small.last(), l = large.last();
+        small.removeLast();
+        alias[s] = l;
+        probability[l] -= 1.0 - probability[s];
+        if (probability[l] < 1.0)
+        {
+            large.removeLast();
+            small.append(l);
+        }
+    }
+    //whatever is left is 1 up to rounding
+    for (int i = 0; i < large.size(); i++)
+        probability[large[i]] = 1.0;
+    for (int i = 0; i < small.size(); i++)
+        probability[small[i]] = 1.0;
+}
+
+void AliasTable::clear()
+{
+    probability.clear();
+    alias.clear();
+}
+
+bool AliasTable::empty() const
+{
+    return probability.isEmpty();
+}
+
+quint32 AliasTable::size() const
+{
+    return probability.size();
+}
+
+quint32 AliasTable::sample(RandomStream &gen) const
+{
+    quint32 i = gen.bounded(probability.size());
+    if (gen.uniform01() < probability[i])
+        return i;
+    return alias[i];
+}
@@ -0,0 +1,30 @@
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "randomstream.h"
+
+/** Walker/Vose alias table over a fixed list of weights
+ * Building costs O(n), every draw afterwards costs O(1):
+ * pick a column uniformly, keep it with probability[column] or take
+ * its alias otherwise.
+ */
+class AliasTable
+{
+public:
+    AliasTable();
+
+    void build(const QVector<quint64> &weight);
+    void clear();
+    bool empty() const;
+    quint32 size() const;
+    quint32 sample(RandomStream &gen) const;
+
+private:
+    QVector<double> probability;
+    QVector<quint32> alias;
+};
+
+#endif // ALIASTABLE_H
@@ -0,0 +1,258 @@
+#include "binarygraphfile.h"
+
+#include <QDebug>
+#include <QSaveFile>
+#include <QVector>
+
+#include <cstring>
+
+const char BinaryGraphFile::Magic[8] = {'R','A','G','G','C','S','R','\0'};
+const quint32 BinaryGraphFile::ByteOrder;
+
+BinaryGraphFile::BinaryGraphFile()
+{
+    data = 0;
+    noOfVertex = 0;
+    noOfEdge = 0;
+}
+
+/** Header plus every array, in bytes
+ * @brief BinaryGraphFile::expected_size
+ */
+qint64 BinaryGraphFile::expected_size(const quint32 &noOfVertex, const quint32 &noOfEdge)
+{
+    qint64 words = qint64(noOfVertex) + 1 + 3 * 2 * qint64(noOfEdge) + 2 * qint64(noOfEdge);
+    return qint64(sizeof(Header)) + words * qint64(sizeof(quint32));
+}
+
+/** Check every array of a mapped file once before it is trusted
+ * Offsets must start at 0, never decrease and end at 2E, and every
+ * neighbour, edge id, twin slot and endpoint must be in range, so a
+ * truncated or corrupted file is rejected instead of read out of bounds.
+ * The same pass over the slots checks what the overlay relies on: the twin
+ * of a slot is another slot in the slice of its neighbour that points back
+ * to this vertex with the same edge id and has it as twin, the edge joins
+ * the two, and every slice is sorted (a self loop is the only repeat)
+ * @brief BinaryGraphFile::validate
+ * @param words the arrays following the header
+ * @param noOfVertex
+ * @param noOfEdge
+ * @return false on the first value out of range or inconsistent
+ */
+bool BinaryGraphFile::validate(const quint32 *words, const quint32 &noOfVertex, const quint32 &noOfEdge)
+{
+    quint64 noOfSlot = 2 * quint64(noOfEdge);
+    const quint32 * offset = words;
+    if (offset[0] != 0 || offset[noOfVertex] != noOfSlot)
+        return false;
+    for (quint32 v = 0; v < noOfVertex; v++)
+        if (offset[v] > offset[v + 1])
+            return false;
+    const quint32 * neighbour = offset + noOfVertex + 1;
+    const quint32 * edgeId = neighbour + noOfSlot;
+    const quint32 * twin = edgeId + noOfSlot;
+    const quint32 * from = twin + noOfSlot;
+    const quint32 * to = from + noOfEdge;
+    for (quint32 e = 0; e < noOfEdge; e++)
+        if (from[e] >= noOfVertex || to[e] >= noOfVertex)
+            return false;
+    for (quint32 v = 0; v < noOfVertex; v++)
+    {
+        for (quint32 s = offset[v]; s < offset[v + 1]; s++)
+        {
+            quint32 u = neighbour[s], e = edgeId[s], t = twin[s];
+            if (u >= noOfVertex || e >= noOfEdge || t >= noOfSlot || t == s)
+                return false;
+            if (s > offset[v] && (neighbour[s - 1] > u || (neighbour[s - 1] == u && u != v)))
+                return false;
+            if (t < offset[u] || t >= offset[u + 1])
+                return false;
+            if (twin[t] != s || neighbour[t] != v || edgeId[t] != e)
+                return false;
+            if (!((from[e] == v && to[e] == u) || (from[e] == u && to[e] == v)))
+                return false;
+        }
+    }
+    return true;
+}
+
+/** Save the base adjacency and the edge table of a loaded graph
+ * The file is written aside and renamed at the end, a process mapping the
+ * previous version never sees a partial file
+ * @brief BinaryGraphFile::write
+ * @param fileName
+ * @param graph
+ * @param edges
+ * @return false if the file could not be written
+ */
+bool BinaryGraphFile::write(const QString &fileName, const CSRGraph &graph, const EdgeTable &edges)
+{
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byteOrder = ByteOrder;
+    header.noOfVertex = graph.getNumberVertex();
+    header.noOfEdge = graph.getNumberEdge();
+    if (edges.size() != header.noOfEdge)
+    {
+        qDebug() << "Binary Graph: Edge Table Does Not Match Adjacency; Not Saving";
+        return false;
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Binary Graph: Cannot Open" << fileName << "For Writing";
+        return false;
+    }
+    quint32 V = header.noOfVertex, E = header.noOfEdge;
+    qint64 slot = 2 * qint64(E) * sizeof(quint32);
+    file.write((const char*) &header, sizeof(Header));
+    file.write((const char*) graph.baseOffsets(), (qint64(V) + 1) * sizeof(quint32));
+    if (E > 0)
+    {
+        file.write((const char*) graph.baseNeighbours(), slot);
+        file.write((const char*) graph.baseEdgeIds(), slot);
+        file.write((const char*) graph.baseTwins(), slot);
+    }
+    QVector<quint32> endpoint(E);
+    for (quint32 e = 0; e < E; e++)
+        endpoint[e] = edges.getFrom(e);
+    file.write((const char*) endpoint.constData(), qint64(E) * sizeof(quint32));
+    for (quint32 e = 0; e < E; e++)
+        endpoint[e] = edges.getTo(e);
+    file.write((const char*) endpoint.constData(), qint64(E) * sizeof(quint32));
+    if (!file.commit())
+    {
+        qDebug() << "Binary Graph: Error While Writing" << fileName;
+        return false;
+    }
+    return true;
+}
+
+/** Map a binary graph file read only
+ * The magic, version, byte order and the size implied by V and E are all
+ * checked, a file from another format version or machine is rejected, then
+ * validate() makes one pass over the arrays
+ * @brief BinaryGraphFile::open
+ * @param fileName
+ * @return false if the file is missing, unmappable or invalid
+ */
+bool BinaryGraphFile::open(const QString &fileName)
+{
+    close();
+    QSharedPointer<QFile> file(new QFile(fileName));
+    if (!file->open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Binary Graph: Cannot Open" << fileName;
+        return false;
+    }
+    qint64 size = file->size();
+    if (size < qint64(sizeof(Header)))
+    {
+        qDebug() << "Binary Graph: File Too Small" << fileName;
+        return false;
+    }
+    uchar * map = file->map(0, size);
+    if (!map)
+    {
+        qDebug() << "Binary Graph: Cannot Map" << fileName;
+        return false;
+    }
+    Header header;
+    memcpy(&header, map, sizeof(Header));
+    if (memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+    {
+        qDebug() << "Binary Graph: Not A Binary Graph File" << fileName;
+        return false;
+    }
+    if (header.version != Version)
+    {
+        qDebug() << "Binary Graph: Unsupported Version" << header.version << "; Expected" << Version;
+        return false;
+    }
+    if (header.byteOrder != ByteOrder)
+    {
+        qDebug() << "Binary Graph: File Written With Another Byte Order";
+        return false;
+    }
+    if (size != expected_size(header.noOfVertex, header.noOfEdge))
+    {
+        qDebug() << "Binary Graph: Size Does Not Match Header; V:" << header.noOfVertex << "; E:" << header.noOfEdge;
+        return false;
+    }
+    const quint32 * words = (const quint32*) (map + sizeof(Header));
+    if (!validate(words, header.noOfVertex, header.noOfEdge))
+    {
+        qDebug() << "Binary Graph: Corrupted Arrays In" << fileName;
+        return false;
+    }
+    mapping = file;
+    data = words;
+    noOfVertex = header.noOfVertex;
+    noOfEdge = header.noOfEdge;
+    return true;
+}
+
+/** Drop this handle on the mapping
+ * The pages stay mapped while a CSRGraph adopted from it is alive
+ * @brief BinaryGraphFile::close
+ */
+void BinaryGraphFile::close()
+{
+    mapping.clear();
+    data = 0;
+    noOfVertex = 0;
+    noOfEdge = 0;
+}
+
+bool BinaryGraphFile::isOpen() const
+{
+    return data != 0;
+}
+
+quint32 BinaryGraphFile::getNumberVertex() const
+{
+    return noOfVertex;
+}
+
+quint32 BinaryGraphFile::getNumberEdge() const
+{
+    return noOfEdge;
+}
+
+const quint32 *BinaryGraphFile::offsets() const
+{
+    return data;
+}
+
+const quint32 *BinaryGraphFile::neighbours() const
+{
+    return offsets() + noOfVertex + 1;
+}
+
+const quint32 *BinaryGraphFile::edgeIds() const
+{
+    return neighbours() + 2 * noOfEdge;
+}
+
+const quint32 *BinaryGraphFile::twins() const
+{
+    return edgeIds() + 2 * noOfEdge;
+}
+
+const quint32 *BinaryGraphFile::from() const
+{
+    return twins() + 2 * noOfEdge;
+}
+
+const quint32 *BinaryGraphFile::to() const
+{
+    return from() + noOfEdge;
+}
+
+QSharedPointer<QFile> BinaryGraphFile::getMapping() const
+{
+    return mapping;
+}
@@ -0,0 +1,63 @@
+#ifndef BINARYGRAPHFILE_H
+#define BINARYGRAPHFILE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QFile>
+#include <QSharedPointer>
+
+#include "csrgraph.h"
+#include "edgetable.h"
+
+/** Versioned binary image of a loaded graph
+ * A 32 byte header (magic, version, byte order marker, V, E) is followed by
+ * the quint32 arrays offset[V+1], neighbour[2E], edgeId[2E], twin[2E],
+ * from[E] and to[E] in native byte order, exactly as CSRGraph and EdgeTable
+ * hold them. open() maps the file read only, so loading costs no parsing and
+ * processes opening the same file share its pages through the page cache.
+ */
+class BinaryGraphFile
+{
+public:
+    enum { Version = 1 };
+
+    BinaryGraphFile();
+
+    static bool write(const QString &fileName, const CSRGraph &graph, const EdgeTable &edges);
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const;
+
+    quint32 getNumberVertex() const;
+    quint32 getNumberEdge() const;
+    const quint32 * offsets() const;
+    const quint32 * neighbours() const;
+    const quint32 * edgeIds() const;
+    const quint32 * twins() const;
+    const quint32 * from() const;
+    const quint32 * to() const;
+    QSharedPointer<QFile> getMapping() const;
+
+private:
+    struct Header
+    {
+        char magic[8];
+        quint32 version;
+        quint32 byteOrder;
+        quint32 noOfVertex;
+        quint32 noOfEdge;
+        quint32 reserved[2];
+    };
+    static const char Magic[8];
+    static const quint32 ByteOrder = 0x01020304;
+
+    static qint64 expected_size(const quint32 &noOfVertex, const quint32 &noOfEdge);
+    static bool validate(const quint32 * words, const quint32 &noOfVertex, const quint32 &noOfEdge);
+
+    QSharedPointer<QFile> mapping;
+    const quint32 * data;
+    quint32 noOfVertex;
+    quint32 noOfEdge;
+};
+
+#endif // BINARYGRAPHFILE_H
@@ -0,0 +1,217 @@
+#include "bucketqueue.h"
+
+#include <algorithm>
+
+BucketQueue::BucketQueue()
+{
+    head = NoBucket;
+    tail = NoBucket;
+}
+
+/** Sort the items by key, ties in index order, and cut the buckets
+ * A counting sort when the keys are small next to n, a stable sort
+ * otherwise, so a view next to a hub does not pay for the hub's degree
+ * @brief BucketQueue::build
+ * @param key
+ */
+void BucketQueue::build(const QVector<quint32> &key)
+{
+    quint32 n = key.size();
+    myKey = key;
+    quint32 maxKey = 0;
+    for (quint32 i = 0; i < n; i++)
+        maxKey = qMax(maxKey, key[i]);
+    order.resize(n);
+    if (maxKey <= 2 * n)
+    {
+        QVector<quint32> filled(maxKey + 2, 0);
+        for (quint32 i = 0; i < n; i++)
+            filled[key[i] + 1]++;
+        for (quint32 k = 0; k <= maxKey; k++)
+            filled[k + 1] += filled[k];
+        for (quint32 i = 0; i < n; i++)
+            order[filled[key[i]]++] = i;
+    }
+    else
+    {
+        for (quint32 i = 0; i < n; i++)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&key](quint32 a, quint32 b) { return key[a] < key[b]; });
+    }
+    position.resize(n);
+    bucketOf.resize(n);
+    bucketKey.clear();
+    bucketStart.clear();
+    prevBucket.clear();
+    nextBucket.clear();
+    freeBucket.clear();
+    head = NoBucket;
+    tail = NoBucket;
+    for (quint32 p = 0; p < n; p++)
+    {
+        quint32 i = order[p];
+        position[i] = p;
+        if (tail == NoBucket || bucketKey[tail] != key[i])
+            insert_bucket(key[i], p, tail);
+        bucketOf[i] = tail;
+    }
+}
+
+quint32 BucketQueue::getKey(const quint32 &i) const
+{
+    return myKey[i];
+}
+
+/** Move i from bucket k to bucket k-1
+ * @brief BucketQueue::decrement
+ * @param i
+ */
+void BucketQueue::decrement(const quint32 &i)
+{
+    if (myKey[i] > 0)
+        decrease_to(i, myKey[i] - 1);
+}
+
+/** Lower the key of i to k, nothing happens if it is already lower
+ * i leaves through the front of its bucket, which puts it at the end of
+ * the bucket below; that repeats until the bucket below has a key not
+ * above k, which i then joins, or a bucket for k is opened right there
+ * @brief BucketQueue::decrease_to
+ * @param i
+ * @param k
+ */
+void BucketQueue::decrease_to(const quint32 &i, const quint32 &k)
+{
+    if (myKey[i] <= k)
+        return;
+    quint32 b = bucketOf[i];
+    for (;;)
+    {
+        quint32 first = bucketStart[b];
+        quint32 j = order[first];
+        order[position[i]] = j;
+        position[j] = position[i];
+        order[first] = i;
+        position[i] = first;
+        bucketStart[b]++;
+        quint32 below = prevBucket[b];
+        if (bucketStart[b] == end_of(b))
+            unlink_bucket(b);
+        if (below != NoBucket && bucketKey[below] > k)
+        {
+            b = below;
+            continue;
+        }
+        if (below != NoBucket && bucketKey[below] == k)
+            bucketOf[i] = below;
+        else
+            bucketOf[i] = insert_bucket(k, first, below);
+        break;
+    }
+    myKey[i] = k;
+}
+
+/** Highest key that still holds an item, 0 if every key is 0
+ * @brief BucketQueue::getMaxKey
+ */
+quint32 BucketQueue::getMaxKey()
+{
+    return tail == NoBucket ? 0 : bucketKey[tail];
+}
+
+/** Uniform pick among the items with the highest key
+ * @brief BucketQueue::sample_max
+ * @param gen
+ * @return
+ */
+quint32 BucketQueue::sample_max(RandomStream &gen)
+{
+    return order[bucketStart[tail] + gen.bounded(end_of(tail) - bucketStart[tail])];
+}
+
+/** Lowest key above 0 that still holds an item, 0 if there is none
+ * @brief BucketQueue::getMinKey
+ */
+quint32 BucketQueue::getMinKey()
+{
+    quint32 b = lowest_above_zero();
+    return b == NoBucket ? 0 : bucketKey[b];
+}
+
+/** Uniform pick among the items with the lowest key above 0
+ * @brief BucketQueue::sample_min
+ * @param gen
+ * @return
+ */
+quint32 BucketQueue::sample_min(RandomStream &gen)
+{
+    quint32 b = lowest_above_zero();
+    return order[bucketStart[b] + gen.bounded(end_of(b) - bucketStart[b])];
+}
+
+/** One past the last position of bucket b
+ * @brief BucketQueue::end_of
+ * @param b
+ */
+quint32 BucketQueue::end_of(const quint32 &b) const
+{
+    return nextBucket[b] == NoBucket ? order.size() : bucketStart[nextBucket[b]];
+}
+
+quint32 BucketQueue::lowest_above_zero() const
+{
+    if (head != NoBucket && bucketKey[head] == 0)
+        return nextBucket[head];
+    return head;
+}
+
+/** Open a bucket for key right after prev (first when prev is NoBucket)
+ * @brief BucketQueue::insert_bucket
+ * @return the bucket, a freed one is reused
+ */
+quint32 BucketQueue::insert_bucket(const quint32 &key, const quint32 &start, const quint32 &prev)
+{
+    quint32 b;
+    if (freeBucket.isEmpty())
+    {
+        b = bucketKey.size();
+        bucketKey.append(key);
+        bucketStart.append(start);
+        prevBucket.append(prev);
+        nextBucket.append(NoBucket);
+    }
+    else
+    {
+        b = freeBucket.last();
+        freeBucket.removeLast();
+        bucketKey[b] = key;
+        bucketStart[b] = start;
+        prevBucket[b] = prev;
+    }
+    quint32 next = prev == NoBucket ? head : nextBucket[prev];
+    nextBucket[b] = next;
+    if (prev == NoBucket)
+        head = b;
+    else
+        nextBucket[prev] = b;
+    if (next == NoBucket)
+        tail = b;
+    else
+        prevBucket[next] = b;
+    return b;
+}
+
+void BucketQueue::unlink_bucket(const quint32 &b)
+{
+    quint32 prev = prevBucket[b], next = nextBucket[b];
+    if (prev == NoBucket)
+        head = next;
+    else
+        nextBucket[prev] = next;
+    if (next == NoBucket)
+        tail = prev;
+    else
+        prevBucket[next] = prev;
+    freeBucket.append(b);
+}
@@ -0,0 +1,58 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <random>
+
+#include "randomstream.h"
+
+/** Items 0..n-1 kept sorted by a key that only ever decreases
+ * order holds the items grouped by key and position[i] is where item i
+ * sits (Batagelj-Zaversnik layout). Only keys that hold an item have a
+ * bucket: the buckets form a list in increasing key order, each one the
+ * range of order from its start to the start of the next, so memory is
+ * O(n) whatever the keys are. Lowering a key swaps the item to the front
+ * of its bucket and moves the border, once per bucket passed on the way
+ * down, so it costs at most the number of keys in between; the highest
+ * and the lowest buckets are the ends of the list and a uniform pick among
+ * their items is O(1). Key 0 is where callers park the items they no
+ * longer want to see, getMinKey() skips it.
+ */
+class BucketQueue
+{
+public:
+    BucketQueue();
+
+    void build(const QVector<quint32> &key);
+    quint32 getKey(const quint32 &i) const;
+    void decrement(const quint32 &i);
+    void decrease_to(const quint32 &i, const quint32 &k);
+    quint32 getMaxKey();
+    quint32 sample_max(RandomStream &gen);
+    quint32 getMinKey();
+    quint32 sample_min(RandomStream &gen);
+
+private:
+    enum { NoBucket = 0xFFFFFFFF };
+
+    quint32 end_of(const quint32 &b) const;
+    quint32 lowest_above_zero() const;
+    quint32 insert_bucket(const quint32 &key, const quint32 &start, const quint32 &prev);
+    void unlink_bucket(const quint32 &b);
+
+    QVector<quint32> myKey;
+    QVector<quint32> order;
+    QVector<quint32> position;
+    QVector<quint32> bucketOf;
+    //non-empty buckets, linked in increasing key order
+    QVector<quint32> bucketKey;
+    QVector<quint32> bucketStart;
+    QVector<quint32> prevBucket;
+    QVector<quint32> nextBucket;
+    QVector<quint32> freeBucket;
+    quint32 head;
+    quint32 tail;
+};
+
+#endif // BUCKETQUEUE_H
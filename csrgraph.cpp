@@ -0,0 +1,545 @@
+#include "csrgraph.h"
+
+#include "parallelrange.h"
+#include "sortedintersection.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+CSRGraph::CSRGraph()
+{
+    noOfEdge = 0;
+    epoch = 1;
+    bind_base();
+}
+
+CSRGraph::CSRGraph(const CSRGraph &other)
+{
+    *this = other;
+}
+
+/** Copies share the base, whether it is owned or mapped from a file
+ * @brief CSRGraph::operator =
+ */
+CSRGraph &CSRGraph::operator=(const CSRGraph &other)
+{
+    offset = other.offset;
+    neighbour = other.neighbour;
+    edgeId = other.edgeId;
+    twin = other.twin;
+    noOfEdge = other.noOfEdge;
+    mapping = other.mapping;
+    liveNeighbour = other.liveNeighbour;
+    liveEdgeId = other.liveEdgeId;
+    liveTwin = other.liveTwin;
+    liveDegree = other.liveDegree;
+    stamp = other.stamp;
+    epoch = other.epoch;
+    if (mapping.isNull())
+        bind_base();
+    else
+    {
+        myOffset = other.myOffset;
+        myNeighbour = other.myNeighbour;
+        myEdgeId = other.myEdgeId;
+        myTwin = other.myTwin;
+    }
+    return *this;
+}
+
+/** Build the adjacency from an edge list, dropping repeated edges
+ * (u,v) and (v,u) are the same edge, its first occurrence in the list is
+ * kept and the kept edges are numbered in list order.
+ * Every step runs on all cores: endpoint degrees are counted with atomic
+ * increments, each edge is scattered to one slot in the slice of each
+ * endpoint through an atomic cursor, then every slice is sorted by
+ * (neighbour, list index), which makes the result independent of the
+ * scatter order. Repeats are now next to each other in the slice of
+ * their smaller endpoint, they are marked there, the edges are renumbered
+ * by a prefix sum over chunks and the slices compacted. After that u
+ * appears once in the slice of v (twice for a self loop), so the twin of
+ * a slot is found by a binary search in the slice of its neighbour.
+ * @brief CSRGraph::build
+ * @param noOfVertex
+ * @param edge
+ * @param unique receives the kept edges in list order
+ * @return false if an endpoint is out of range
+ */
+bool CSRGraph::build(const quint32 &noOfVertex, const std::vector<QPair<quint32,quint32> > &edge,
+                     std::vector<QPair<quint32,quint32> > &unique)
+{
+    clear();
+    //every edge takes two slots, slot indices are quint32
+    if (edge.size() > 0x7FFFFFFF)
+    {
+        qDebug() << "CSR: Too Many Edges" << quint64(edge.size()) << "; Terminating ...";
+        unique.clear();
+        return false;
+    }
+    quint32 m = quint32(edge.size());
+    const QPair<quint32,quint32> * list = edge.data();
+
+    //degrees, the first bad edge seen by each thread is kept for the message
+    quint32 noOfThread = ParallelRange::getNumberThread(m, ChunkSize);
+    QVector<quint32> firstBad(noOfThread, m);
+    std::vector<std::atomic<quint32> > cursor(noOfVertex);
+    ParallelRange::run(m, ChunkSize, [&](quint32 thread, quint32 begin, quint32 end)
+    {
+        for (quint32 i = begin; i < end; i++)
+        {
+            if (list[i].first >= noOfVertex || list[i].second >= noOfVertex)
+            {
+                firstBad[thread] = qMin(firstBad[thread], i);
+                break;
+            }
+            cursor[list[i].first].fetch_add(1, std::memory_order_relaxed);
+            cursor[list[i].second].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    quint32 bad = m;
+    for (quint32 t = 0; t < noOfThread; t++)
+        bad = qMin(bad, firstBad.at(t));
+    if (bad < m)
+    {
+        qDebug() << "CSR: Edge Endpoint Out Of Range" << list[bad].first << list[bad].second << "; Terminating ...";
+        clear();
+        unique.clear();
+        return false;
+    }
+    QVector<quint32> start(noOfVertex + 1);
+    start[0] = 0;
+    for (quint32 v = 0; v < noOfVertex; v++)
+    {
+        start[v + 1] = start[v] + cursor[v].load(std::memory_order_relaxed);
+        cursor[v].store(start[v], std::memory_order_relaxed);
+    }
+
+    //a slot packs (neighbour, list index), sorting a slice sorts by both
+    const quint32 * first = start.constData();
+    std::vector<quint64> slot(first[noOfVertex]);
+    ParallelRange::run(m, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 i = begin; i < end; i++)
+        {
+            quint32 from = list[i].first, to = list[i].second;
+            slot[cursor[from].fetch_add(1, std::memory_order_relaxed)] = (quint64(to) << 32) | i;
+            slot[cursor[to].fetch_add(1, std::memory_order_relaxed)] = (quint64(from) << 32) | i;
+        }
+    });
+    QVector<quint8> repeated(m, 0);
+    quint8 * isRepeated = repeated.data();
+    ParallelRange::run(noOfVertex, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 v = begin; v < end; v++)
+        {
+            std::sort(slot.begin() + first[v], slot.begin() + first[v + 1]);
+            //only the smaller endpoint marks, so each edge has one writer
+            for (quint32 s = first[v], head = first[v]; s < first[v + 1]; s++)
+            {
+                quint32 u = quint32(slot[s] >> 32);
+                if (u < v)
+                    continue;
+                if (u != quint32(slot[head] >> 32))
+                    head = s;
+                else if (quint32(slot[s]) != quint32(slot[head]))
+                    isRepeated[quint32(slot[s])] = 1;
+            }
+        }
+    });
+
+    //new index of every kept edge: kept edges before it, counted per chunk
+    //of ChunkSize edges, the chunks are the items handed to the threads
+    quint32 noOfChunk = (quint64(m) + ChunkSize - 1) / ChunkSize;
+    QVector<quint32> chunkStart(noOfChunk + 1, 0);
+    quint32 * keptInChunk = chunkStart.data();
+    ParallelRange::run(noOfChunk, 1, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 c = begin; c < end; c++)
+        {
+            quint32 k = 0;
+            quint32 last = quint32(qMin(quint64(m), (quint64(c) + 1) * ChunkSize));
+            for (quint32 i = c * ChunkSize; i < last; i++)
+                k += 1 - isRepeated[i];
+            keptInChunk[c + 1] = k;
+        }
+    });
+    for (quint32 c = 0; c < noOfChunk; c++)
+        chunkStart[c + 1] += chunkStart[c];
+    quint32 noOfKept = chunkStart[noOfChunk];
+    bool compact = noOfKept < m;
+    if (compact)
+        unique.resize(noOfKept);
+    else
+        unique = edge;
+    QPair<quint32,quint32> * kept = compact ? unique.data() : 0;
+    QVector<quint32> newId(m);
+    quint32 * renumbered = newId.data();
+    ParallelRange::run(noOfChunk, 1, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 c = begin; c < end; c++)
+        {
+            quint32 k = keptInChunk[c];
+            quint32 last = quint32(qMin(quint64(m), (quint64(c) + 1) * ChunkSize));
+            for (quint32 i = c * ChunkSize; i < last; i++)
+            {
+                if (isRepeated[i])
+                    continue;
+                renumbered[i] = k;
+                if (kept)
+                    kept[k] = list[i];
+                k++;
+            }
+        }
+    });
+
+    //compacted slices, still sorted by neighbour then edge index
+    offset.fill(0, noOfVertex + 1);
+    quint32 * off = offset.data();
+    ParallelRange::run(noOfVertex, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 v = begin; v < end; v++)
+        {
+            quint32 d = 0;
+            for (quint32 s = first[v]; s < first[v + 1]; s++)
+                d += 1 - isRepeated[quint32(slot[s])];
+            off[v + 1] = d;
+        }
+    });
+    for (quint32 v = 0; v < noOfVertex; v++)
+        offset[v + 1] += offset[v];
+    quint32 noOfSlot = offset[noOfVertex];
+    neighbour.resize(noOfSlot);
+    edgeId.resize(noOfSlot);
+    twin.resize(noOfSlot);
+    quint32 * nb = neighbour.data();
+    quint32 * eid = edgeId.data();
+    quint32 * tw = twin.data();
+    ParallelRange::run(noOfVertex, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 v = begin; v < end; v++)
+        {
+            quint32 t = off[v];
+            for (quint32 s = first[v]; s < first[v + 1]; s++)
+            {
+                quint32 i = quint32(slot[s]);
+                if (isRepeated[i])
+                    continue;
+                nb[t] = quint32(slot[s] >> 32);
+                eid[t] = renumbered[i];
+                t++;
+            }
+        }
+    });
+    //the two slots of an edge are each other's twin, a self loop has both in one slice
+    ParallelRange::run(noOfVertex, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 v = begin; v < end; v++)
+        {
+            for (quint32 t = off[v]; t < off[v + 1]; t++)
+            {
+                quint32 u = nb[t];
+                quint32 s = std::lower_bound(nb + off[u], nb + off[u + 1], v) - nb;
+                if (s == t)
+                    s++;
+                tw[t] = s;
+            }
+        }
+    });
+    noOfEdge = noOfKept;
+
+    liveNeighbour.resize(noOfSlot);
+    liveEdgeId.resize(noOfSlot);
+    liveTwin.resize(noOfSlot);
+    liveDegree.resize(noOfVertex);
+    stamp.fill(0, noOfVertex);
+    epoch = 1;
+    bind_base();
+    return true;
+}
+
+/** Use base arrays that live outside this object, typically a mapped
+ * binary graph file, without copying them
+ * The arrays must hold the layout build() produces (sorted slices, twins)
+ * and stay valid as long as owner is alive
+ * @brief CSRGraph::adopt
+ * @param noOfVertex
+ * @param noOfEdge
+ * @param offsets noOfVertex + 1 entries
+ * @param neighbours 2 * noOfEdge entries, edgeIds and twins likewise
+ * @param owner keeps the mapping alive, shared by all copies
+ */
+void CSRGraph::adopt(const quint32 &noOfVertex, const quint32 &noOfEdge,
+                     const quint32 *offsets, const quint32 *neighbours,
+                     const quint32 *edgeIds, const quint32 *twins,
+                     QSharedPointer<QFile> owner)
+{
+    clear();
+    mapping = owner;
+    myOffset = offsets;
+    myNeighbour = neighbours;
+    myEdgeId = edgeIds;
+    myTwin = twins;
+    this->noOfEdge = noOfEdge;
+
+    quint32 noOfSlot = 2 * noOfEdge;
+    liveNeighbour.resize(noOfSlot);
+    liveEdgeId.resize(noOfSlot);
+    liveTwin.resize(noOfSlot);
+    liveDegree.resize(noOfVertex);
+    stamp.fill(0, noOfVertex);
+    epoch = 1;
+}
+
+/** Raw base arrays, for writers of the binary format
+ * @brief CSRGraph::baseOffsets
+ */
+const quint32 *CSRGraph::baseOffsets() const
+{
+    return myOffset;
+}
+
+const quint32 *CSRGraph::baseNeighbours() const
+{
+    return myNeighbour;
+}
+
+const quint32 *CSRGraph::baseEdgeIds() const
+{
+    return myEdgeId;
+}
+
+const quint32 *CSRGraph::baseTwins() const
+{
+    return myTwin;
+}
+
+void CSRGraph::clear()
+{
+    offset.clear();
+    neighbour.clear();
+    edgeId.clear();
+    twin.clear();
+    noOfEdge = 0;
+    mapping.clear();
+    liveNeighbour.clear();
+    liveEdgeId.clear();
+    liveTwin.clear();
+    liveDegree.clear();
+    stamp.clear();
+    epoch = 1;
+    bind_base();
+}
+
+/** Forget every detachment of the previous run, all edges are attached again
+ * Only bumps the epoch, the stamps are cleared when it wraps around
+ * @brief CSRGraph::reset
+ */
+void CSRGraph::reset()
+{
+    epoch++;
+    if (epoch == 0)
+    {
+        stamp.fill(0);
+        epoch = 1;
+    }
+}
+
+quint32 CSRGraph::getNumberVertex() const
+{
+    return stamp.size();
+}
+
+quint32 CSRGraph::getNumberEdge() const
+{
+    return noOfEdge;
+}
+
+quint32 CSRGraph::getDegree(const quint32 &v) const
+{
+    if (is_touched(v))
+        return liveDegree[v];
+    return getInitialDegree(v);
+}
+
+quint32 CSRGraph::getInitialDegree(const quint32 &v) const
+{
+    return myOffset[v + 1] - myOffset[v];
+}
+
+const quint32 *CSRGraph::neighbours(const quint32 &v) const
+{
+    if (is_touched(v))
+        return liveNeighbour.constData() + myOffset[v];
+    return initialNeighbours(v);
+}
+
+const quint32 *CSRGraph::edges(const quint32 &v) const
+{
+    if (is_touched(v))
+        return liveEdgeId.constData() + myOffset[v];
+    return initialEdges(v);
+}
+
+const quint32 *CSRGraph::initialNeighbours(const quint32 &v) const
+{
+    return myNeighbour + myOffset[v];
+}
+
+const quint32 *CSRGraph::initialEdges(const quint32 &v) const
+{
+    return myEdgeId + myOffset[v];
+}
+
+/** Live neighbours of v in increasing order
+ * The base slice is sorted already, the live slice of a vertex that lost
+ * edges is not and gets copied to buffer and sorted there
+ * @brief CSRGraph::sortedNeighbours
+ * @param v
+ * @param buffer
+ * @return getDegree(v) indices
+ */
+const quint32 *CSRGraph::sortedNeighbours(const quint32 &v, QVector<quint32> &buffer) const
+{
+    if (!is_touched(v))
+        return initialNeighbours(v);
+    quint32 d = liveDegree[v];
+    buffer.resize(d);
+    const quint32 * adj = liveNeighbour.constData() + myOffset[v];
+    for (quint32 i = 0; i < d; i++)
+        buffer[i] = adj[i];
+    std::sort(buffer.begin(), buffer.end());
+    return buffer.constData();
+}
+
+/** Number of distinct vertices adjacent to both u and w
+ * A self loop puts a vertex twice in its own slice, so the slices are cut at
+ * u and w: the strictly increasing pieces in between go to the intersection
+ * kernels and a vertex at a cut counts once when both slices hold it.
+ * Touched slices are sorted into the scratch buffers of the graph, which
+ * stop allocating once they have grown.
+ * @brief CSRGraph::countCommonNeighbours
+ * @param u
+ * @param w
+ */
+quint32 CSRGraph::countCommonNeighbours(const quint32 &u, const quint32 &w) const
+{
+    const quint32 * a = sortedNeighbours(u, scratch[0]);
+    const quint32 * b = sortedNeighbours(w, scratch[1]);
+    const quint32 * aEnd = a + getDegree(u);
+    const quint32 * bEnd = b + getDegree(w);
+    const quint32 cut[2] = { qMin(u, w), qMax(u, w) };
+    quint32 count = 0;
+    for (int k = 0; k < 2; k++)
+    {
+        const quint32 * aCut = std::lower_bound(a, aEnd, cut[k]);
+        const quint32 * bCut = std::lower_bound(b, bEnd, cut[k]);
+        count += SortedIntersection::count(a, aCut - a, b, bCut - b);
+        a = std::upper_bound(aCut, aEnd, cut[k]);
+        b = std::upper_bound(bCut, bEnd, cut[k]);
+        if (a != aCut && b != bCut)
+            count++;
+    }
+    return count + SortedIntersection::count(a, aEnd - a, b, bEnd - b);
+}
+
+quint32 CSRGraph::getNeighbour(const quint32 &v, const quint32 &i) const
+{
+    return neighbours(v)[i];
+}
+
+quint32 CSRGraph::getEdge(const quint32 &v, const quint32 &i) const
+{
+    return edges(v)[i];
+}
+
+/** Remove the i-th live edge of v from both of its endpoints in O(1)
+ * @brief CSRGraph::detach
+ * @param v
+ * @param i
+ */
+void CSRGraph::detach(const quint32 &v, const quint32 &i)
+{
+    quint32 u = getNeighbour(v, i);
+    touch(v);
+    touch(u);
+    release(v, myOffset[v] + i);
+    //the released slot now sits right behind the live range of v
+    release(u, liveTwin[myOffset[v] + liveDegree[v]]);
+}
+
+/** Remove every live edge of v, v becomes isolated
+ * @brief CSRGraph::detach_all
+ * @param v
+ */
+void CSRGraph::detach_all(const quint32 &v)
+{
+    while (getDegree(v) > 0)
+        detach(v, getDegree(v) - 1);
+}
+
+bool CSRGraph::is_touched(const quint32 &v) const
+{
+    return stamp[v] == epoch;
+}
+
+/** Copy the base slice of v into the overlay before its first detachment
+ * Slots keep their position, so twin links stay valid across both copies
+ * @brief CSRGraph::touch
+ */
+void CSRGraph::touch(const quint32 &v)
+{
+    if (is_touched(v))
+        return;
+    for (quint32 s = myOffset[v]; s < myOffset[v + 1]; s++)
+    {
+        liveNeighbour[s] = myNeighbour[s];
+        liveEdgeId[s] = myEdgeId[s];
+        liveTwin[s] = myTwin[s];
+    }
+    liveDegree[v] = getInitialDegree(v);
+    stamp[v] = epoch;
+}
+
+/** Swap slot s of v with its last live slot and shrink the live range
+ * @brief CSRGraph::release
+ */
+void CSRGraph::release(const quint32 &v, const quint32 &s)
+{
+    quint32 last = myOffset[v] + liveDegree[v] - 1;
+    swap_slots(s, last);
+    liveDegree[v]--;
+}
+
+/** Exchange two overlay slots of the same vertex and keep the twin links valid
+ * The opposite endpoints are copied to the overlay first, so an untouched
+ * vertex can always trust the twin links of the base.
+ * The two slots of a self loop are each other's twin and hold the same
+ * content, they are left untouched
+ * @brief CSRGraph::swap_slots
+ */
+void CSRGraph::swap_slots(const quint32 &a, const quint32 &b)
+{
+    if (a == b || liveTwin[a] == b)
+        return;
+    touch(liveNeighbour[a]);
+    touch(liveNeighbour[b]);
+    qSwap(liveNeighbour[a], liveNeighbour[b]);
+    qSwap(liveEdgeId[a], liveEdgeId[b]);
+    qSwap(liveTwin[a], liveTwin[b]);
+    liveTwin[liveTwin[a]] = a;
+    liveTwin[liveTwin[b]] = b;
+}
+
+/** Point the base views at the owned arrays
+ * @brief CSRGraph::bind_base
+ */
+void CSRGraph::bind_base()
+{
+    myOffset = offset.constData();
+    myNeighbour = neighbour.constData();
+    myEdgeId = edgeId.constData();
+    myTwin = twin.constData();
+}
@@ -0,0 +1,97 @@
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <QtGlobal>
+#include <QPair>
+#include <QVector>
+#include <QSharedPointer>
+#include <QFile>
+
+#include <vector>
+
+/** Compressed Sparse Row adjacency of the loaded graph
+ * The neighbours of vertex v are stored contiguously in
+ * neighbour[offset[v] .. offset[v+1]) in increasing order, edgeId holds the index of the edge
+ * occupying the same slot and twin the slot of that edge in the other
+ * endpoint. These base arrays are never modified after build.
+ * A run works on an overlay: the slice of a vertex is copied the first time
+ * one of its slots has to move and only the first liveDegree[v] slots of the
+ * copy are still attached. Detaching swaps the slot behind the live range of
+ * both endpoints, so aggregations never allocate, free or search anything,
+ * and reset() drops the whole overlay without touching the base.
+ * The base is read through plain pointers, so it can also be adopted from
+ * a mapped binary graph file and shared by every copy without a copy.
+ */
+class CSRGraph
+{
+public:
+    CSRGraph();
+    CSRGraph(const CSRGraph &other);
+    CSRGraph &operator=(const CSRGraph &other);
+
+    bool build(const quint32 &noOfVertex, const std::vector<QPair<quint32,quint32> > &edge,
+               std::vector<QPair<quint32,quint32> > &unique);
+    void adopt(const quint32 &noOfVertex, const quint32 &noOfEdge,
+               const quint32 * offsets, const quint32 * neighbours,
+               const quint32 * edgeIds, const quint32 * twins,
+               QSharedPointer<QFile> owner);
+    void clear();
+    void reset();
+
+    quint32 getNumberVertex() const;
+    quint32 getNumberEdge() const;
+
+    quint32 getDegree(const quint32 &v) const;
+    quint32 getInitialDegree(const quint32 &v) const;
+    const quint32 * neighbours(const quint32 &v) const;
+    const quint32 * edges(const quint32 &v) const;
+    const quint32 * initialNeighbours(const quint32 &v) const;
+    const quint32 * initialEdges(const quint32 &v) const;
+    const quint32 * sortedNeighbours(const quint32 &v, QVector<quint32> &buffer) const;
+    quint32 countCommonNeighbours(const quint32 &u, const quint32 &w) const;
+    quint32 getNeighbour(const quint32 &v, const quint32 &i) const;
+    quint32 getEdge(const quint32 &v, const quint32 &i) const;
+
+    void detach(const quint32 &v, const quint32 &i);
+    void detach_all(const quint32 &v);
+
+    const quint32 * baseOffsets() const;
+    const quint32 * baseNeighbours() const;
+    const quint32 * baseEdgeIds() const;
+    const quint32 * baseTwins() const;
+
+private:
+    enum { ChunkSize = 4096 };
+
+    bool is_touched(const quint32 &v) const;
+    void touch(const quint32 &v);
+    void release(const quint32 &v, const quint32 &s);
+    void swap_slots(const quint32 &a, const quint32 &b);
+    void bind_base();
+
+    //immutable base, owned when built here
+    QVector<quint32> offset;
+    QVector<quint32> neighbour;
+    QVector<quint32> edgeId;
+    QVector<quint32> twin;
+    quint32 noOfEdge;
+    //the mapped file the base comes from when it is adopted
+    QSharedPointer<QFile> mapping;
+    const quint32 * myOffset;
+    const quint32 * myNeighbour;
+    const quint32 * myEdgeId;
+    const quint32 * myTwin;
+
+    //overlay of the current run
+    QVector<quint32> liveNeighbour;
+    QVector<quint32> liveEdgeId;
+    QVector<quint32> liveTwin;
+    QVector<quint32> liveDegree;
+    QVector<quint32> stamp;
+    quint32 epoch;
+
+    //sorted copies of touched slices, kept to be reused by every count
+    mutable QVector<quint32> scratch[2];
+};
+
+#endif // CSRGRAPH_H
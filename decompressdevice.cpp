@@ -0,0 +1,403 @@
+#include "decompressdevice.h"
+
+#include <QDebug>
+
+#include <cstring>
+
+#include <zlib.h>
+#ifdef RANAGG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+DecompressDevice::DecompressDevice(const QString &fileName)
+{
+    this->fileName = fileName;
+    format = detect_format(fileName);
+    head = 0;
+    count = 0;
+    readPos = 0;
+    finished = true;
+    failed = false;
+    stopping = false;
+}
+
+DecompressDevice::~DecompressDevice()
+{
+    close();
+}
+
+/** Compression of a file, from its suffix
+ * @brief DecompressDevice::detect_format
+ * @param fileName
+ */
+DecompressDevice::Format DecompressDevice::detect_format(const QString &fileName)
+{
+    if (fileName.endsWith(".gz", Qt::CaseInsensitive))
+        return Gzip;
+    if (fileName.endsWith(".zst", Qt::CaseInsensitive))
+        return Zstd;
+    return Plain;
+}
+
+/** A name filter followed by its compressed variants
+ * "*.txt" gives "*.txt", "*.txt.gz" and, when built with zstd, "*.txt.zst"
+ * @brief DecompressDevice::getNameFilters
+ * @param filter
+ */
+QStringList DecompressDevice::getNameFilters(const QString &filter)
+{
+    QStringList filters;
+    filters << filter << filter + ".gz";
+#ifdef RANAGG_HAVE_ZSTD
+    filters << filter + ".zst";
+#endif
+    return filters;
+}
+
+/** Pick between two copies of the same input, a plain copy wins
+ * @brief DecompressDevice::prefer_plain
+ * @param current file picked so far, may be empty
+ * @param candidate
+ */
+QString DecompressDevice::prefer_plain(const QString &current, const QString &candidate)
+{
+    if (current.isEmpty() || detect_format(current) != Plain)
+        return candidate;
+    return current;
+}
+
+/** Open a file for reading text whether it is compressed or not
+ * @brief DecompressDevice::open_file
+ * @param fileName
+ * @return a QFile or a DecompressDevice owned by the caller, 0 on failure
+ */
+QIODevice *DecompressDevice::open_file(const QString &fileName)
+{
+    QIODevice * device;
+    if (detect_format(fileName) == Plain)
+        device = new QFile(fileName);
+    else
+        device = new DecompressDevice(fileName);
+    if (!device->open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qDebug() << "Cannot Open" << fileName;
+        delete device;
+        return 0;
+    }
+    return device;
+}
+
+/** Open the source file and start decompressing ahead of the reader
+ * @brief DecompressDevice::open
+ * @param mode read only
+ */
+bool DecompressDevice::open(OpenMode mode)
+{
+    if (mode & QIODevice::WriteOnly)
+    {
+        qDebug() << "Decompress: Compressed Files Are Read Only";
+        return false;
+    }
+    if (format == Plain)
+    {
+        qDebug() << "Decompress: Not A Compressed File" << fileName;
+        return false;
+    }
+#ifndef RANAGG_HAVE_ZSTD
+    if (format == Zstd)
+    {
+        qDebug() << "Decompress: Built Without zstd Support (CONFIG += zstd)" << fileName;
+        return false;
+    }
+#endif
+    close();
+    source.setFileName(fileName);
+    if (!source.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Decompress: Cannot Open" << fileName;
+        return false;
+    }
+    block.resize(NoOfBlock);
+    for (int i = 0; i < NoOfBlock; i++)
+        block[i].resize(BlockSize);
+    blockSize.fill(0, NoOfBlock);
+    head = 0;
+    count = 0;
+    readPos = 0;
+    finished = false;
+    failed = false;
+    stopping = false;
+    QIODevice::open(mode);
+    producer = std::thread(&DecompressDevice::produce, this);
+    return true;
+}
+
+/** Stop the producer, also when the reader did not reach the end
+ * @brief DecompressDevice::close
+ */
+void DecompressDevice::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    changed.notify_all();
+    if (producer.joinable())
+        producer.join();
+    source.close();
+    QIODevice::close();
+}
+
+bool DecompressDevice::isSequential() const
+{
+    return true;
+}
+
+/** At end only once the producer is done and every block is consumed
+ * @brief DecompressDevice::atEnd
+ */
+bool DecompressDevice::atEnd() const
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!finished || count > 0)
+            return false;
+    }
+    return QIODevice::atEnd();
+}
+
+qint64 DecompressDevice::bytesAvailable() const
+{
+    qint64 available = 0;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (quint32 i = 0; i < count; i++)
+            available += blockSize[(head + i) % NoOfBlock];
+        if (count > 0)
+            available -= readPos;
+    }
+    return available + QIODevice::bytesAvailable();
+}
+
+/** Copy decompressed bytes, waiting for the producer when nothing is ready
+ * @brief DecompressDevice::readData
+ * @return bytes copied, 0 at the end, -1 if the file is corrupted
+ */
+qint64 DecompressDevice::readData(char *data, qint64 maxSize)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (count == 0 && !finished)
+        changed.wait(guard);
+    if (count == 0)
+        return failed ? -1 : 0;
+    qint64 n = 0;
+    while (n < maxSize && count > 0)
+    {
+        qint64 k = qMin(maxSize - n, blockSize[head] - readPos);
+        memcpy(data + n, block[head].constData() + readPos, k);
+        n += k;
+        readPos += k;
+        if (readPos == blockSize[head])
+        {
+            head = (head + 1) % NoOfBlock;
+            count--;
+            readPos = 0;
+            changed.notify_all();
+        }
+    }
+    return n;
+}
+
+qint64 DecompressDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+/** Body of the producer thread
+ * @brief DecompressDevice::produce
+ */
+void DecompressDevice::produce()
+{
+    QByteArray input;
+    input.resize(BlockSize);
+    bool ok = format == Gzip ? inflate_gzip(input) : decompress_zstd(input);
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finished = true;
+        failed = !ok;
+    }
+    changed.notify_all();
+}
+
+/** Inflate the whole source into the ring
+ * Concatenated members (pigz, bgzip) are decoded one after the other
+ * @brief DecompressDevice::inflate_gzip
+ * @param input read buffer
+ * @return false on a read error or corrupted / truncated data
+ */
+bool DecompressDevice::inflate_gzip(QByteArray &input)
+{
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    //15 window bits, +32 detects the gzip or zlib header
+    if (inflateInit2(&z, 15 + 32) != Z_OK)
+    {
+        qDebug() << "Decompress: Cannot Initialise zlib";
+        return false;
+    }
+    char * out = acquire_block();
+    z.next_out = (Bytef*) out;
+    z.avail_out = BlockSize;
+    bool ok = true, ended = false, full = false;
+    while (out)
+    {
+        //a full output block may leave output pending, drain it before reading on
+        if (z.avail_in == 0 && !full)
+        {
+            qint64 n = source.read(input.data(), input.size());
+            if (n < 0)
+            {
+                qDebug() << "Decompress: Read Error In" << fileName;
+                ok = false;
+                break;
+            }
+            if (n == 0)
+                break;
+            z.next_in = (Bytef*) input.data();
+            z.avail_in = uInt(n);
+        }
+        int ret = inflate(&z, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END)
+        {
+            ended = true;
+            if (z.avail_in > 0 || !source.atEnd())
+            {
+                inflateReset(&z);
+                ended = false;
+            }
+        }
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+        {
+            qDebug() << "Decompress: Corrupted gzip Data In" << fileName;
+            ok = false;
+            break;
+        }
+        full = z.avail_out == 0;
+        if (full)
+        {
+            publish_block(BlockSize);
+            out = acquire_block();
+            z.next_out = (Bytef*) out;
+            z.avail_out = BlockSize;
+        }
+    }
+    if (out)
+        publish_block(BlockSize - z.avail_out);
+    inflateEnd(&z);
+    if (ok && out && !ended)
+    {
+        qDebug() << "Decompress: Truncated gzip File" << fileName;
+        ok = false;
+    }
+    return ok;
+}
+
+/** Decompress the whole zstd source into the ring
+ * @brief DecompressDevice::decompress_zstd
+ * @param input read buffer
+ * @return false on a read error or corrupted / truncated data
+ */
+bool DecompressDevice::decompress_zstd(QByteArray &input)
+{
+#ifdef RANAGG_HAVE_ZSTD
+    ZSTD_DCtx * context = ZSTD_createDCtx();
+    if (!context)
+    {
+        qDebug() << "Decompress: Cannot Initialise zstd";
+        return false;
+    }
+    ZSTD_inBuffer in = { input.constData(), 0, 0 };
+    char * out = acquire_block();
+    ZSTD_outBuffer outBuffer = { out, size_t(BlockSize), 0 };
+    bool ok = true, full = false;
+    size_t hint = 0;
+    while (out)
+    {
+        if (in.pos == in.size && !full)
+        {
+            qint64 n = source.read(input.data(), input.size());
+            if (n < 0)
+            {
+                qDebug() << "Decompress: Read Error In" << fileName;
+                ok = false;
+                break;
+            }
+            if (n == 0)
+                break;
+            in.src = input.constData();
+            in.size = size_t(n);
+            in.pos = 0;
+        }
+        hint = ZSTD_decompressStream(context, &outBuffer, &in);
+        if (ZSTD_isError(hint))
+        {
+            qDebug() << "Decompress: Corrupted zstd Data In" << fileName << ZSTD_getErrorName(hint);
+            ok = false;
+            break;
+        }
+        full = outBuffer.pos == outBuffer.size;
+        if (full)
+        {
+            publish_block(BlockSize);
+            out = acquire_block();
+            outBuffer.dst = out;
+            outBuffer.pos = 0;
+        }
+    }
+    if (out)
+        publish_block(outBuffer.pos);
+    ZSTD_freeDCtx(context);
+    //a complete frame leaves no hint of further input
+    if (ok && out && hint != 0)
+    {
+        qDebug() << "Decompress: Truncated zstd File" << fileName;
+        ok = false;
+    }
+    return ok;
+#else
+    Q_UNUSED(input);
+    return false;
+#endif
+}
+
+/** The next free block of the ring, waits while the reader is behind
+ * @brief DecompressDevice::acquire_block
+ * @return 0 once the device is closed
+ */
+char *DecompressDevice::acquire_block()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (count == NoOfBlock && !stopping)
+        changed.wait(guard);
+    if (stopping)
+        return 0;
+    return block[(head + count) % NoOfBlock].data();
+}
+
+/** Hand the block returned by acquire_block() over to the reader
+ * @brief DecompressDevice::publish_block
+ * @param size bytes written to it
+ */
+void DecompressDevice::publish_block(const qint64 &size)
+{
+    if (size == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        blockSize[(head + count) % NoOfBlock] = size;
+        count++;
+    }
+    changed.notify_all();
+}
@@ -0,0 +1,73 @@
+#ifndef DECOMPRESSDEVICE_H
+#define DECOMPRESSDEVICE_H
+
+#include <QtGlobal>
+#include <QIODevice>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/** Sequential read only device over a gzip (.gz) or zstd (.zst) file
+ * A producer thread reads and decompresses the file into a small ring of
+ * fixed blocks while the reader consumes the previous ones, so the parser
+ * never waits for the disk and the decompressor at the same time and the
+ * memory used does not depend on the file size.
+ * zstd support needs libzstd and RANAGG_HAVE_ZSTD (CONFIG += zstd).
+ */
+class DecompressDevice : public QIODevice
+{
+public:
+    enum Format { Plain, Gzip, Zstd };
+
+    DecompressDevice(const QString &fileName);
+    ~DecompressDevice();
+
+    static Format detect_format(const QString &fileName);
+    static QStringList getNameFilters(const QString &filter);
+    static QString prefer_plain(const QString &current, const QString &candidate);
+    static QIODevice * open_file(const QString &fileName);
+
+    bool open(OpenMode mode);
+    void close();
+    bool isSequential() const;
+    bool atEnd() const;
+    qint64 bytesAvailable() const;
+
+protected:
+    qint64 readData(char * data, qint64 maxSize);
+    qint64 writeData(const char * data, qint64 maxSize);
+
+private:
+    enum { BlockSize = 1 << 20, NoOfBlock = 4 };
+
+    void produce();
+    bool inflate_gzip(QByteArray &input);
+    bool decompress_zstd(QByteArray &input);
+    char * acquire_block();
+    void publish_block(const qint64 &size);
+
+    QString fileName;
+    Format format;
+    QFile source;
+    std::thread producer;
+
+    //ring of decompressed blocks, guarded by lock
+    mutable std::mutex lock;
+    std::condition_variable changed;
+    QVector<QByteArray> block;
+    QVector<qint64> blockSize;
+    quint32 head;
+    quint32 count;
+    qint64 readPos;
+    bool finished;
+    bool failed;
+    bool stopping;
+};
+
+#endif // DECOMPRESSDEVICE_H
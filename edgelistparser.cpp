@@ -0,0 +1,296 @@
+#include "edgelistparser.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QByteArray>
+
+#include <algorithm>
+
+#include "parallelrange.h"
+#include "decompressdevice.h"
+
+EdgeListParser::EdgeListParser(std::vector<QPair<quint32,quint32> > *edge)
+{
+    this->edge = edge;
+    limit = 0;
+    noOfPair = 0;
+    noOfLine = 0;
+    noOfSkipped = 0;
+    state = LineStart;
+    value = 0;
+    column = 0;
+    bad = false;
+}
+
+/** Stop after maxPair pairs, 0 means no limit
+ * @brief EdgeListParser::setLimit
+ * @param maxPair
+ */
+void EdgeListParser::setLimit(const quint64 &maxPair)
+{
+    limit = maxPair;
+}
+
+bool EdgeListParser::isFull() const
+{
+    return limit > 0 && noOfPair >= limit;
+}
+
+/** Parse the next size bytes of the input
+ * @brief EdgeListParser::feed
+ * @param data
+ * @param size
+ */
+void EdgeListParser::feed(const char *data, const qint64 &size)
+{
+    const char * p = data, * end = data + size;
+    while (p < end && !isFull())
+    {
+        char c = *p++;
+        if (c == '\n')
+        {
+            end_line();
+            continue;
+        }
+        if (state == Skip)
+            continue;
+        if (c >= '0' && c <= '9')
+        {
+            value = value * 10 + quint32(c - '0');
+            state = Number;
+            if (value > 0xFFFFFFFF)
+            {
+                bad = true;
+                state = Skip;
+            }
+        }
+        else if (c == '\t' || c == ' ' || c == ',' || c == '\r')
+        {
+            if (state == Number)
+                end_number();
+        }
+        else if (state == LineStart && (c == '#' || c == '%'))
+            state = Skip;
+        else
+        {
+            bad = true;
+            state = Skip;
+        }
+    }
+}
+
+/** End of input, a last line without newline still counts
+ * @brief EdgeListParser::finish
+ */
+void EdgeListParser::finish()
+{
+    if (state != LineStart || column > 0)
+        end_line();
+}
+
+/** Parse a whole file
+ * The file is mapped when possible, otherwise it is read through a fixed
+ * buffer, a line is never copied in either case. Compressed files are
+ * decompressed on another thread while the parser consumes them
+ * @brief EdgeListParser::read_file
+ * @param fileName
+ * @return false if the file cannot be opened or decompressed
+ */
+bool EdgeListParser::read_file(const QString &fileName)
+{
+    if (DecompressDevice::detect_format(fileName) != DecompressDevice::Plain)
+    {
+        DecompressDevice device(fileName);
+        if (!device.open(QIODevice::ReadOnly))
+            return false;
+        bool ok = read_device(&device);
+        device.close();
+        finish();
+        return ok;
+    }
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Edge List: Cannot Open" << fileName;
+        return false;
+    }
+    qint64 size = file.size();
+    uchar * map = size > 0 ? file.map(0, size) : 0;
+    if (map)
+    {
+        feed((const char*) map, size);
+        file.unmap(map);
+    }
+    else if (!read_device(&file))
+        return false;
+    finish();
+    file.close();
+    return true;
+}
+
+/** Parse everything an open device delivers through a fixed buffer
+ * @brief EdgeListParser::read_device
+ * @param device
+ * @return false on a read error
+ */
+bool EdgeListParser::read_device(QIODevice *device)
+{
+    QByteArray buffer;
+    buffer.resize(ReadBufferSize);
+    qint64 n = 0;
+    while (!isFull() && (n = device->read(buffer.data(), ReadBufferSize)) > 0)
+        feed(buffer.constData(), n);
+    if (n < 0)
+    {
+        qDebug() << "Edge List: Error While Reading";
+        return false;
+    }
+    return true;
+}
+
+quint64 EdgeListParser::getNumberLine() const
+{
+    return noOfLine;
+}
+
+quint64 EdgeListParser::getNumberSkipped() const
+{
+    return noOfSkipped;
+}
+
+/** First pair of a file, e.g. V and E of a vertex file
+ * @brief EdgeListParser::read_header
+ * @param fileName
+ * @param first
+ * @param second
+ * @return false if the file holds no pair
+ */
+bool EdgeListParser::read_header(const QString &fileName, quint32 &first, quint32 &second)
+{
+    std::vector<QPair<quint32,quint32> > header;
+    EdgeListParser parser(&header);
+    parser.setLimit(1);
+    if (!parser.read_file(fileName) || header.empty())
+        return false;
+    first = header.front().first;
+    second = header.front().second;
+    return true;
+}
+
+/** Parse a whole file on all cores, pairs keep their order in the file
+ * The mapped file is cut into pieces of PieceSize bytes, each moved to the
+ * start of its first complete line, so every line belongs to exactly one
+ * piece. Threads pull pieces and parse them into piece local lists, a
+ * prefix sum of the list sizes then gives every piece its place in edge
+ * and the pieces are copied there in parallel.
+ * Files that are small, compressed or cannot be mapped are parsed by
+ * read_file().
+ * @brief EdgeListParser::read_file_parallel
+ * @param fileName
+ * @param edge the pairs are appended, it can be reserved by the caller
+ * @param noOfSkipped malformed lines
+ * @return false if the file cannot be opened
+ */
+bool EdgeListParser::read_file_parallel(const QString &fileName, std::vector<QPair<quint32,quint32> > *edge,
+                                        quint64 &noOfSkipped)
+{
+    noOfSkipped = 0;
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Edge List: Cannot Open" << fileName;
+        return false;
+    }
+    qint64 size = file.size();
+    quint32 noOfPiece = quint32((quint64(size) + PieceSize - 1) / PieceSize);
+    uchar * map = 0;
+    if (noOfPiece > 1 && ParallelRange::getNumberThread() > 1
+            && DecompressDevice::detect_format(fileName) == DecompressDevice::Plain)
+        map = file.map(0, size);
+    if (!map)
+    {
+        file.close();
+        EdgeListParser parser(edge);
+        if (!parser.read_file(fileName))
+            return false;
+        noOfSkipped = parser.getNumberSkipped();
+        return true;
+    }
+
+    const char * text = (const char*) map;
+    std::vector<std::vector<QPair<quint32,quint32> > > local(noOfPiece);
+    QVector<quint64> skipped(noOfPiece, 0);
+    std::vector<QPair<quint32,quint32> > * piece = local.data();
+    quint64 * pieceSkipped = skipped.data();
+    ParallelRange::run(noOfPiece, 1, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 i = begin; i < end; i++)
+        {
+            qint64 from = line_start(text, size, qint64(i) * PieceSize);
+            qint64 to = line_start(text, size, qMin(size, qint64(i + 1) * PieceSize));
+            EdgeListParser parser(&piece[i]);
+            parser.feed(text + from, to - from);
+            parser.finish();
+            pieceSkipped[i] = parser.getNumberSkipped();
+        }
+    });
+
+    QVector<quint64> start(noOfPiece + 1, 0);
+    for (quint32 i = 0; i < noOfPiece; i++)
+    {
+        start[i + 1] = start[i] + piece[i].size();
+        noOfSkipped += skipped[i];
+    }
+    quint64 base = edge->size();
+    edge->resize(base + start[noOfPiece]);
+    QPair<quint32,quint32> * out = edge->data() + base;
+    const quint64 * offset = start.constData();
+    ParallelRange::run(noOfPiece, 1, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 i = begin; i < end; i++)
+        {
+            std::copy(piece[i].begin(), piece[i].end(), out + offset[i]);
+            piece[i] = std::vector<QPair<quint32,quint32> >();
+        }
+    });
+    file.unmap(map);
+    file.close();
+    return true;
+}
+
+/** First byte of the first line starting at or after pos
+ * @brief EdgeListParser::line_start
+ */
+qint64 EdgeListParser::line_start(const char *text, const qint64 &size, const qint64 &pos)
+{
+    if (pos <= 0)
+        return 0;
+    const char * newline = std::find(text + pos - 1, text + size, '\n');
+    return qMin(size, qint64(newline - text) + 1);
+}
+
+void EdgeListParser::end_number()
+{
+    field[column++] = quint32(value);
+    value = 0;
+    //anything after the second field is ignored
+    state = column == 2 ? Skip : Field;
+}
+
+void EdgeListParser::end_line()
+{
+    noOfLine++;
+    if (state == Number)
+        end_number();
+    if (column == 2)
+    {
+        edge->push_back(qMakePair(field[0], field[1]));
+        noOfPair++;
+    }
+    else if (bad || column == 1)
+        noOfSkipped++;
+    state = LineStart;
+    value = 0;
+    column = 0;
+    bad = false;
+}
@@ -0,0 +1,64 @@
+#ifndef EDGELISTPARSER_H
+#define EDGELISTPARSER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QIODevice>
+#include <QVector>
+#include <QPair>
+
+#include <vector>
+
+/** Streaming parser of whitespace separated edge lists
+ * Every line holding at least two unsigned integers yields the pair of its
+ * first two fields, further fields (weights) are ignored. Fields are split
+ * by tabs, spaces or commas, lines starting with '#' or '%' are comments and
+ * lines with anything else before the second field are counted as skipped.
+ * The input can be fed in chunks split anywhere, even inside a number: the
+ * state of the current line is a handful of integers, so parsing allocates
+ * nothing besides the pairs appended to the caller's (reserved) list.
+ * read_file_parallel() splits a mapped file into newline aligned pieces
+ * parsed by one parser each on all cores.
+ */
+class EdgeListParser
+{
+public:
+    EdgeListParser(std::vector<QPair<quint32,quint32> > * edge);
+
+    void setLimit(const quint64 &maxPair);
+    bool isFull() const;
+    void feed(const char * data, const qint64 &size);
+    void finish();
+    bool read_file(const QString &fileName);
+
+    quint64 getNumberLine() const;
+    quint64 getNumberSkipped() const;
+
+    static bool read_header(const QString &fileName, quint32 &first, quint32 &second);
+    static bool read_file_parallel(const QString &fileName, std::vector<QPair<quint32,quint32> > * edge,
+                                   quint64 &noOfSkipped);
+
+private:
+    enum State { LineStart, Field, Number, Skip };
+    enum { ReadBufferSize = 1 << 20 };
+    enum { PieceSize = 1 << 23 };
+
+    static qint64 line_start(const char * text, const qint64 &size, const qint64 &pos);
+
+    bool read_device(QIODevice * device);
+    void end_number();
+    void end_line();
+
+    std::vector<QPair<quint32,quint32> > * edge;
+    quint64 limit;
+    quint64 noOfPair;
+    quint64 noOfLine;
+    quint64 noOfSkipped;
+    State state;
+    quint64 value;
+    quint32 field[2];
+    quint32 column;
+    bool bad;
+};
+
+#endif // EDGELISTPARSER_H
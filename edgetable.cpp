@@ -0,0 +1,92 @@
+#include "edgetable.h"
+
+const quint32 EdgeTable::NoEdge;
+
+EdgeTable::EdgeTable()
+{
+}
+
+/** Fill the table from an edge list, edge i of the list gets index i
+ * @brief EdgeTable::build
+ * @param edge
+ */
+void EdgeTable::build(const std::vector<QPair<quint32,quint32> > &edge)
+{
+    quint32 n = edge.size();
+    from.resize(n);
+    to.resize(n);
+    for (quint32 i = 0; i < n; i++)
+    {
+        from[i] = edge[i].first;
+        to[i] = edge[i].second;
+    }
+    alive.fill(true, n);
+}
+
+/** Fill the table from two endpoint arrays of n edges each
+ * @brief EdgeTable::build
+ * @param from
+ * @param to
+ * @param n
+ */
+void EdgeTable::build(const quint32 *from, const quint32 *to, const quint32 &n)
+{
+    this->from.resize(n);
+    this->to.resize(n);
+    for (quint32 i = 0; i < n; i++)
+    {
+        this->from[i] = from[i];
+        this->to[i] = to[i];
+    }
+    alive.fill(true, n);
+}
+
+void EdgeTable::clear()
+{
+    from.clear();
+    to.clear();
+    alive.clear();
+}
+
+quint32 EdgeTable::size() const
+{
+    return from.size();
+}
+
+quint32 EdgeTable::getFrom(const quint32 &e) const
+{
+    return from[e];
+}
+
+quint32 EdgeTable::getTo(const quint32 &e) const
+{
+    return to[e];
+}
+
+/** Return the endpoint of e that is not v
+ * @brief EdgeTable::getOther
+ */
+quint32 EdgeTable::getOther(const quint32 &e, const quint32 &v) const
+{
+    return from[e] == v ? to[e] : from[e];
+}
+
+bool EdgeTable::hasEndpoint(const quint32 &e, const quint32 &v) const
+{
+    return from[e] == v || to[e] == v;
+}
+
+bool EdgeTable::isAlive(const quint32 &e) const
+{
+    return alive.testBit(e);
+}
+
+void EdgeTable::kill(const quint32 &e)
+{
+    alive.clearBit(e);
+}
+
+void EdgeTable::revive_all()
+{
+    alive.fill(true);
+}
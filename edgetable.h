@@ -0,0 +1,42 @@
+#ifndef EDGETABLE_H
+#define EDGETABLE_H
+
+#include <QtGlobal>
+#include <QBitArray>
+#include <QPair>
+#include <QVector>
+
+#include <vector>
+
+/** Struct-of-arrays store of the undirected edges
+ * Edge e joins vertex from[e] and to[e] (8 bytes per edge),
+ * alive marks the edges that have not been detached by an aggregation
+ */
+class EdgeTable
+{
+public:
+    static const quint32 NoEdge = 0xFFFFFFFF;
+
+    EdgeTable();
+
+    void build(const std::vector<QPair<quint32,quint32> > &edge);
+    void build(const quint32 * from, const quint32 * to, const quint32 &n);
+    void clear();
+    quint32 size() const;
+
+    quint32 getFrom(const quint32 &e) const;
+    quint32 getTo(const quint32 &e) const;
+    quint32 getOther(const quint32 &e, const quint32 &v) const;
+    bool hasEndpoint(const quint32 &e, const quint32 &v) const;
+
+    bool isAlive(const quint32 &e) const;
+    void kill(const quint32 &e);
+    void revive_all();
+
+private:
+    QVector<quint32> from;
+    QVector<quint32> to;
+    QBitArray alive;
+};
+
+#endif // EDGETABLE_H
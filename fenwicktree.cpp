@@ -0,0 +1,73 @@
+#include "fenwicktree.h"
+
+FenwickTree::FenwickTree()
+{
+    highBit = 0;
+}
+
+/** n slots, all of weight 0
+ * @brief FenwickTree::reset
+ * @param n
+ */
+void FenwickTree::reset(const quint32 &n)
+{
+    tree.fill(0, n + 1);
+    weight.fill(0, n);
+    highBit = 1;
+    while (highBit <= n / 2)
+        highBit <<= 1;
+}
+
+void FenwickTree::set(const quint32 &i, const quint64 &w)
+{
+    quint64 old = weight[i];
+    if (old == w)
+        return;
+    weight[i] = w;
+    for (quint32 k = i + 1; k < (quint32) tree.size(); k += k & (0 - k))
+        tree[k] += w - old; //wraps around when decreasing, the sum stays exact
+}
+
+quint64 FenwickTree::get(const quint32 &i) const
+{
+    return weight[i];
+}
+
+quint64 FenwickTree::total() const
+{
+    quint64 sum = 0;
+    for (quint32 k = weight.size(); k > 0; k -= k & (0 - k))
+        sum += tree[k];
+    return sum;
+}
+
+/** Slot i such that prefix(i) <= target < prefix(i) + weight[i]
+ * @brief FenwickTree::find
+ * @param target must be below total()
+ * @return
+ */
+quint32 FenwickTree::find(quint64 target) const
+{
+    quint32 pos = 0;
+    quint32 n = weight.size();
+    for (quint32 step = highBit; step > 0; step >>= 1)
+    {
+        quint32 next = pos + step;
+        if (next <= n && tree[next] <= target)
+        {
+            pos = next;
+            target -= tree[next];
+        }
+    }
+    return pos;
+}
+
+/** Draw a slot with probability weight[i] / total()
+ * @brief FenwickTree::sample
+ * @param gen
+ * @return
+ */
+quint32 FenwickTree::sample(RandomStream &gen) const
+{
+    return find(gen.bounded64(total()));
+}
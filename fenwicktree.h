@@ -0,0 +1,31 @@
+#ifndef FENWICKTREE_H
+#define FENWICKTREE_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "randomstream.h"
+
+/** Binary indexed tree over non-negative weights
+ * Point updates, prefix sums and weighted draws all cost O(log n),
+ * so a sampler can follow weights that change after every merge.
+ */
+class FenwickTree
+{
+public:
+    FenwickTree();
+
+    void reset(const quint32 &n);
+    void set(const quint32 &i, const quint64 &w);
+    quint64 get(const quint32 &i) const;
+    quint64 total() const;
+    quint32 find(quint64 target) const;
+    quint32 sample(RandomStream &gen) const;
+
+private:
+    QVector<quint64> tree;
+    QVector<quint64> weight;
+    quint32 highBit;
+};
+
+#endif // FENWICKTREE_H
@@ -0,0 +1,289 @@
+#include "gmlreader.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QByteArray>
+
+#include <cstring>
+
+GMLReader::GMLReader()
+{
+    state = Space;
+    keyLength = 0;
+    hasKey = false;
+    value = 0;
+    negative = false;
+    integer = true;
+    hasField[0] = hasField[1] = false;
+    directed = false;
+    noOfMalformed = 0;
+}
+
+/** Tokenize the next size bytes of the input
+ * @brief GMLReader::feed
+ * @param data
+ * @param size
+ */
+void GMLReader::feed(const char *data, const qint64 &size)
+{
+    const char * end = data + size;
+    for (const char * p = data; p < end; p++)
+    {
+        char c = *p;
+        switch (state)
+        {
+        case Comment:
+            if (c == '\n')
+                state = Space;
+            continue;
+        case String:
+            if (c == '"')
+            {
+                state = Space;
+                end_value(false);
+            }
+            continue;
+        case Key:
+            if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')
+            {
+                if (keyLength < KeySize)
+                    key[keyLength] = c;
+                keyLength++;
+                continue;
+            }
+            state = Space;
+            end_key();
+            break;
+        case Number:
+            if (c >= '0' && c <= '9')
+            {
+                if (value <= 0xFFFFFFFF)
+                    value = value * 10 + quint32(c - '0');
+                else
+                    integer = false;
+                continue;
+            }
+            if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')
+            {
+                integer = false;
+                continue;
+            }
+            state = Space;
+            end_value(true);
+            break;
+        case Space:
+            break;
+        }
+
+        //between tokens
+        if (c == '[')
+            open_list();
+        else if (c == ']')
+            close_list();
+        else if (c == '"')
+            state = String;
+        else if (c == '#')
+            state = Comment;
+        else if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+        {
+            value = (c >= '0' && c <= '9') ? quint32(c - '0') : 0;
+            negative = c == '-';
+            integer = c != '.';
+            state = Number;
+        }
+        else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+        {
+            key[0] = c;
+            keyLength = 1;
+            state = Key;
+        }
+    }
+}
+
+/** End of input, unterminated lists are reported
+ * @brief GMLReader::finish
+ */
+void GMLReader::finish()
+{
+    if (state == Number)
+        end_value(true);
+    else if (state == Key)
+        end_key();
+    state = Space;
+    if (!stack.isEmpty())
+    {
+        qDebug() << "Error While Parsing GML:" << stack.size() << "Unclosed List(s)";
+        noOfMalformed += stack.size();
+        stack.clear();
+    }
+}
+
+/** Tokenize a whole file
+ * The file is mapped when possible, otherwise read through a fixed buffer
+ * @brief GMLReader::read_file
+ * @param fileName
+ * @return false if the file cannot be opened
+ */
+bool GMLReader::read_file(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "GML: Cannot Open" << fileName;
+        return false;
+    }
+    qint64 size = file.size();
+    uchar * map = size > 0 ? file.map(0, size) : 0;
+    if (map)
+    {
+        feed((const char*) map, size);
+        file.unmap(map);
+    }
+    else
+    {
+        QByteArray buffer;
+        buffer.resize(ReadBufferSize);
+        qint64 n;
+        while ((n = file.read(buffer.data(), ReadBufferSize)) > 0)
+            feed(buffer.constData(), n);
+    }
+    finish();
+    file.close();
+    return true;
+}
+
+bool GMLReader::isDirected() const
+{
+    return directed;
+}
+
+/** Node ids in file order
+ * @brief GMLReader::getNodes
+ */
+const QVector<quint32> &GMLReader::getNodes() const
+{
+    return nodes;
+}
+
+/** (source, target) ids in file order, duplicates included
+ * @brief GMLReader::getEdges
+ */
+const std::vector<QPair<quint32,quint32> > &GMLReader::getEdges() const
+{
+    return edges;
+}
+
+/** Nodes and edges without usable ids, and unbalanced brackets
+ * @brief GMLReader::getNumberMalformed
+ */
+quint64 GMLReader::getNumberMalformed() const
+{
+    return noOfMalformed;
+}
+
+void GMLReader::end_key()
+{
+    hasKey = true;
+}
+
+/** A number or string completes the pair started by the pending key
+ * @brief GMLReader::end_value
+ * @param isNumber
+ */
+void GMLReader::end_value(const bool &isNumber)
+{
+    if (!hasKey)
+        return;
+    hasKey = false;
+    if (stack.isEmpty())
+        return;
+    bool id = isNumber && integer && !negative && value <= 0xFFFFFFFF;
+    switch (stack.last())
+    {
+    case Graph:
+        if (isNumber && key_is("directed"))
+            directed = value != 0;
+        break;
+    case Node:
+        if (id && key_is("id"))
+        {
+            field[0] = quint32(value);
+            hasField[0] = true;
+        }
+        break;
+    case Edge:
+        if (id && key_is("source"))
+        {
+            field[0] = quint32(value);
+            hasField[0] = true;
+        }
+        else if (id && key_is("target"))
+        {
+            field[1] = quint32(value);
+            hasField[1] = true;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/** '[' opens the list named by the pending key
+ * Only graph at the top level and node / edge right inside it matter,
+ * anything else (graphics, attributes) is skipped with its content
+ * @brief GMLReader::open_list
+ */
+void GMLReader::open_list()
+{
+    quint8 kind = Other;
+    if (hasKey)
+    {
+        if (stack.isEmpty() && key_is("graph"))
+            kind = Graph;
+        else if (!stack.isEmpty() && stack.last() == Graph)
+        {
+            if (key_is("node"))
+                kind = Node;
+            else if (key_is("edge"))
+                kind = Edge;
+        }
+    }
+    hasKey = false;
+    if (kind == Node || kind == Edge)
+        hasField[0] = hasField[1] = false;
+    stack.append(kind);
+}
+
+/** ']' closes the innermost list, a complete node or edge is emitted
+ * @brief GMLReader::close_list
+ */
+void GMLReader::close_list()
+{
+    hasKey = false;
+    if (stack.isEmpty())
+    {
+        noOfMalformed++;
+        return;
+    }
+    quint8 kind = stack.last();
+    stack.removeLast();
+    if (kind == Node)
+    {
+        if (hasField[0])
+            nodes.append(field[0]);
+        else
+            noOfMalformed++;
+    }
+    else if (kind == Edge)
+    {
+        if (hasField[0] && hasField[1])
+            edges.push_back(qMakePair(field[0], field[1]));
+        else
+            noOfMalformed++;
+    }
+}
+
+bool GMLReader::key_is(const char *name) const
+{
+    return keyLength == strlen(name) && memcmp(key, name, keyLength) == 0;
+}
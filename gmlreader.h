@@ -0,0 +1,64 @@
+#ifndef GMLREADER_H
+#define GMLREADER_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include <QPair>
+
+#include <vector>
+
+/** Streaming tokenizer for GML graph files
+ * GML is a nested list of key value pairs, a value being a number, a quoted
+ * string or a [ ... ] list. The reader only keeps the key in front of the
+ * current value and the stack of open lists, so input can be fed in chunks
+ * split anywhere and layout (indentation, line breaks) does not matter.
+ * The id of every node and the source and target of every edge are
+ * collected in file order, labels, values and graphics are skipped.
+ */
+class GMLReader
+{
+public:
+    GMLReader();
+
+    void feed(const char * data, const qint64 &size);
+    void finish();
+    bool read_file(const QString &fileName);
+
+    bool isDirected() const;
+    const QVector<quint32> & getNodes() const;
+    const std::vector<QPair<quint32,quint32> > & getEdges() const;
+    quint64 getNumberMalformed() const;
+
+private:
+    enum State { Space, Key, Number, String, Comment };
+    enum List { Other, Graph, Node, Edge };
+    enum { KeySize = 16, ReadBufferSize = 1 << 20 };
+
+    void end_key();
+    void end_value(const bool &isNumber);
+    void open_list();
+    void close_list();
+    bool key_is(const char * name) const;
+
+    State state;
+    char key[KeySize];
+    quint32 keyLength;
+    bool hasKey;
+    //the number being scanned
+    quint64 value;
+    bool negative;
+    bool integer;
+    //lists currently open, innermost last
+    QVector<quint8> stack;
+    //fields of the node or edge being read
+    quint32 field[2];
+    bool hasField[2];
+
+    bool directed;
+    QVector<quint32> nodes;
+    std::vector<QPair<quint32,quint32> > edges;
+    quint64 noOfMalformed;
+};
+
+#endif // GMLREADER_H
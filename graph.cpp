@@ -1,7 +1,10 @@
 #include "graph.h"
 
+#include <algorithm>
 #include <limits>
 #include <random>
+#include <utility>
+#include <vector>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/erdos_renyi_generator.hpp>
@@ -15,24 +18,71 @@
 #include <boost/graph/circle_layout.hpp>
 #include <boost/graph/strong_components.hpp>
 #include <boost/graph/graph_utility.hpp>
-#include <boost/graph/clustering_coefficient.hpp>
-#include <boost/graph/exterior_property.hpp>
 
 #include <QTime>
 
-std::random_device rd;
-std::mt19937 generator(rd());
-
-
-QString globalDirPath;
-qint32 global_e = 0;
-qint32 global_v = 0;
-static int no_run = 0;
-
 Graph::Graph()
 {   //set up graphic scenes to display all kinds of stuff
     graphIsReady = false;
-    generator.seed(sqrt(QTime::currentTime().msec()*QTime::currentTime().msec()));
+    preset_e = 0;
+    preset_v = 0;
+    no_run = 0;
+    std::random_device rd;
+    setSeed((quint64(rd()) << 32) | rd());
+}
+
+Graph::~Graph()
+{
+    qDeleteAll(myVertexList);
+}
+
+/** Fix the seed of this instance, runs become reproducible
+ * Instances running in parallel on the same seed must use distinct threads,
+ * the run counter restarts at 0
+ * @brief Graph::setSeed
+ * @param seed
+ * @param thread
+ */
+void Graph::setSeed(const quint64 &seed, const quint32 &thread)
+{
+    this->seed = seed;
+    run_id = 0;
+    thread_id = thread;
+    generator.setKey(seed, run_id, thread_id);
+}
+
+RandomStream &Graph::getGenerator()
+{
+    return generator;
+}
+
+/** Take over the graph loaded by another instance without reading it again
+ * The adjacency and edge arrays are implicitly shared and only copied by the
+ * instance that writes to them, so many Graphs can aggregate the same data
+ * in parallel. The source must not be running while it is shared.
+ * @brief Graph::share_loaded_graph
+ * @param source
+ */
+void Graph::share_loaded_graph(const Graph &source)
+{
+    qDeleteAll(myVertexList);
+    myVertexList.clear();
+    for (int i = 0; i < source.myVertexList.size(); i++)
+    {
+        Vertex * v = new Vertex(this);
+        v->setIndex(source.myVertexList.at(i)->getIndex());
+        myVertexList.append(v);
+    }
+    topology = source.topology;
+    myEdges = source.myEdges;
+    triangles = source.triangles;
+    myDirPath = source.myDirPath;
+    preset_e = source.preset_e;
+    preset_v = source.preset_v;
+    no_run = source.no_run;
+    ground_truth_communities = source.ground_truth_communities;
+    large_excluded = source.large_excluded;
+    LARGE_reset();
 }
 
 
@@ -40,6 +90,10 @@ Graph::Graph()
 
 /** READ GML FILE AND PARSE FOR EDGE FILE
  * Otherwise GML takes way too long to parse
+ * The file is tokenized in one streaming pass. Node ids may be any unsigned
+ * numbers, vertices are stored in file order and indexed by that position,
+ * which is what the adjacency and the saved edge file use.
+ * Duplicate edges are dropped in bulk by generate_edges
  * @brief Graph::read_GML_file
  * @param filePath
  */
@@ -52,149 +106,58 @@ void Graph::read_GML_file(QString filePath)
         return;
     }
     GMLpath = filePath;
-    QFileInfo fileInfo(file);
-    QDir dir = fileInfo.absoluteDir();
-    if (!file.exists())
-    {
-        qDebug() << "FILE NOT FOUND";
+    GMLReader reader;
+    if (!reader.read_file(filePath))
         return;
-    }
-
-    file.open(QFile::ReadOnly | QFile::Text);
-    QTextStream in(&file);
-    QString all = in.readAll();
-    QStringList split = all.split("\n");
-    QString directed = split[3];
-    if (!directed.contains("0"))
+    if (reader.isDirected())
     {
         qDebug() << "DIRECTED GRAPH";
         return; //directed graph
     }
-    QSet<int> v;
-    QList<QPair<int,int> > my_edge;
-    QStringListIterator iter(split);
-    while(iter.hasNext())
+    if (reader.getNumberMalformed() > 0)
+        qDebug() << "Error While Parsing GML:" << reader.getNumberMalformed() << "Malformed Node(s) / Edge(s) Skipped";
+
+    const QVector<quint32> &node = reader.getNodes();
+    QHash<quint32,quint32> position;
+    position.reserve(node.size());
+    for (int i = 0; i < node.size(); i++)
     {
-        QString str = iter.next();
-        if (str.contains("node") || str.contains("edge"))
+        if (position.contains(node[i]))
         {
-            bool node = str.contains(" node");
-            bool edge = str.contains(" edge");
-            if (!node && !edge)
-            {
-                qDebug() << "FILE FORMATE ERROR";
-                return;
-            }
-            else
-                iter.next();
-            if (node)
-            {
-                while (iter.peekNext() != "  ]")
-                {
-                    QStringList cur = iter.next().split(" ");
-                    if (cur.contains("id"))
-                    {
-                        bool ok;
-                        int i = cur.last().toInt(&ok);
-                        if (ok)
-                        {
-                            Vertex * v = new Vertex;
-                            v->setIndex(i);
-                            myVertexList.append(v);
-                        }
-                        else
-                            qDebug() << "Error While Parsing GML: id not recognised!";
-                    }
-                    else if (cur.contains("label"))
-                    {
-                        int index = cur.indexOf("label");
-                        index++;
-                        QString label;
-                        for (index; index < cur.size(); index++)
-                        {
-                            label.append(cur.at(index));
-                        }
-                    }
-                    else if (cur.contains("value"))
-                    {
-                        bool ok;
-                        //vertex_weight.append(cur.last().toInt(&ok));
-                        if (!ok)
-                        {
-                            QString c = cur.last();
-                            //QString name = vertex_label.last();
-                            QString parsed_name = "";
-                           // for (int i = 1; i < name.size()-1;i++) parsed_name += name[i];
-                        }
-                    }
-                }
-            }
-            else if (edge)
-            {
-                int source = -1, des = -1;
-                while (iter.peekNext() != "  ]")
-                {
-                    QStringList cur = iter.next().split(" ");
-                    if (cur.contains("source"))
-                    {
-                        source = cur.last().toInt();
-                    }
-                    else if (cur.contains("target"))
-                    {
-                        des = cur.last().toInt();
-                    }
-                    else if (cur.contains("value"))
-                    {
-                      //  edge_weight.append(cur.last().toInt());
-                    }
-                }
-                if (source != -1 && des != -1)
-                {
-                    QPair<int,int> e = qMakePair(source,des);
-                    QPair<int,int> reverse = qMakePair(des,source);
-                    if (!my_edge.contains(e) && !my_edge.contains(reverse))
-                    {
-                        my_edge.append(e);
-                        my_edge.append(reverse);
-                    }
-                    else
-                        qDebug() << "Error While Parsing GML: Duplicate Edge!";
-                }
-                else
-                {
-                    qDebug() << "EDGE ERROR" << source << des;
-                    return;
-                }
-            }
-            else
-            {
-                qDebug() << "ERROR: UNKNOWN ERROR WHILE PARSING! RETURNING";
-                return;
-            }
-
-        }
-        else
+            qDebug() << "Error While Parsing GML: Duplicate Node" << node[i];
             continue;
+        }
+        position.insert(node[i], myVertexList.size());
+        Vertex * v = new Vertex(this);
+        v->setIndex(myVertexList.size());
+        myVertexList.append(v);
     }
-
-    for (int i = 0; i < my_edge.size(); i+= 2)
+    const std::vector<QPair<quint32,quint32> > &gml_edge = reader.getEdges();
+    std::vector<QPair<quint32,quint32> > edge;
+    edge.reserve(gml_edge.size());
+    for (size_t i = 0; i < gml_edge.size(); i++)
     {
-        QPair<int,int> e = my_edge[i];
-        int v = e.first, u = e.second;
-        Vertex * from = myVertexList[v];
-        Vertex * to = myVertexList[u];
-        Edge * newe = new Edge(from,to,i/2);
-        myEdgeList.append(newe);
+        QHash<quint32,quint32>::const_iterator source = position.constFind(gml_edge[i].first),
+                target = position.constFind(gml_edge[i].second);
+        if (source == position.constEnd() || target == position.constEnd())
+        {
+            qDebug() << "EDGE ERROR" << gml_edge[i].first << gml_edge[i].second;
+            return;
+        }
+        edge.push_back(qMakePair(source.value(), target.value()));
     }
+    generate_edges(edge);
 
     qDebug() << "GML Parsed Successfully!";
-    qDebug() << "V: " << myVertexList.size() << "; E: " << myEdgeList.size();
+    qDebug() << "V: " << myVertexList.size() << "; E: " << myEdges.size();
     save_edge_file_from_GML();
 
 }
 
 
 /** Save GML file as Simple .txt File for faster parsing
+ * Vertices are written as their position, so read_simple_edge accepts the
+ * file whatever the GML node ids were
  * @brief Graph::save_edge_file_from_GML
  */
 void Graph::save_edge_file_from_GML()
@@ -211,17 +174,18 @@ void Graph::save_edge_file_from_GML()
         QFile vFile(dir.absolutePath() + "/vertex_file.txt");
         vFile.open(QIODevice::WriteOnly | QIODevice::Text);
         QTextStream os(&vFile);
-        os << QString::number(myVertexList.size()) << '\t' << QString::number(myEdgeList.size()) << endl;
+        os << QString::number(myVertexList.size()) << '\t' << QString::number(myEdges.size()) << endl;
         vFile.close();
 
         QFile outFile(dir.absolutePath() + "/edge_file.txt");
         outFile.open(QIODevice::WriteOnly | QIODevice::Text);
         QTextStream ts(&outFile);
-        for (int i = 0; i < myEdgeList.size(); i++)
+        //'\n' instead of endl, the stream is flushed once at the end
+        for (quint32 i = 0; i < myEdges.size(); i++)
         {
-            int from = myEdgeList[i]->fromVertex()->getIndex(), to = myEdgeList[i]->toVertex()->getIndex();
-            ts << QString::number(from) << '\t' << QString::number(to) << endl;
+            ts << myEdges.getFrom(i) << '\t' << myEdges.getTo(i) << '\n';
         }
+        ts.flush();
         outFile.close();
     }
 }
@@ -237,9 +201,9 @@ void Graph::save_current_run_as_edge_file(QString fileName)
     outFile.open(QIODevice::WriteOnly | QIODevice::Text);
     QTextStream ts(&outFile);
     ts << "Source\tTarget" << endl;
-    for (int i = 0; i < myEdgeList.size(); i++)
+    for (quint32 i = 0; i < myEdges.size(); i++)
     {
-        quint32 from = myEdgeList[i]->fromVertex()->getIndex(), to = myEdgeList[i]->toVertex()->getIndex();
+        quint32 from = myVertexList.at(myEdges.getFrom(i))->getIndex(), to = myVertexList.at(myEdges.getTo(i))->getIndex();
         ts << QString::number(from) << '\t' << QString::number(to) << endl;
     }
     outFile.close();
@@ -257,9 +221,9 @@ void Graph::read_simple_edge(QString dirPath)
         qDebug() << "DIR NOT EXISTS! Terminating ...";
         return;
     }
-    globalDirPath = dirPath;
+    myDirPath = dirPath;
     QStringList filters;
-    filters << "*.txt";
+    filters << DecompressDevice::getNameFilters("*.txt");
     QFileInfoList file = dir.entryInfoList(filters);
     QString v_file, e_file;
     for (int i = 0; i < file.size(); i++)
@@ -267,15 +231,23 @@ void Graph::read_simple_edge(QString dirPath)
         QFileInfo f = file.at(i);
         QString name = f.fileName();
         if (name.contains("edge"))
-            e_file = f.absoluteFilePath();
+            e_file = DecompressDevice::prefer_plain(e_file, f.absoluteFilePath());
         else if (name.contains("vertex"))
-            v_file = f.absoluteFilePath();
+            v_file = DecompressDevice::prefer_plain(v_file, f.absoluteFilePath());
         else
         {
             qDebug() << "While READING FILES: File not Recognised!";
             qDebug() << file[i].fileName() << " Skipping this File";
         }
     }
+    //a converted graph.bin newer than the edge file is mapped instead of parsed
+    QFileInfo binary(dir.absoluteFilePath("graph.bin"));
+    if (binary.exists() && (e_file.isEmpty() || binary.lastModified() >= QFileInfo(e_file).lastModified()))
+    {
+        if (read_binary_graph(binary.absoluteFilePath()))
+            return;
+        qDebug() << "Falling Back To Text Files";
+    }
 
     //reload original vertices
     //Parsing
@@ -286,56 +258,33 @@ void Graph::read_simple_edge(QString dirPath)
         return;
     }
     //else
-    vfile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream vin(&vfile);
-    QStringList str = vin.readLine().split('\t');
-    bool load;
-    global_v = str[0].toUInt(&load);
-    global_e = str[1].toUInt(&load);
-    if (!load)
+    if (!EdgeListParser::read_header(v_file, preset_v, preset_e))
     {
         qDebug() << "ERROR LOADING V FILE";
         return;
     }
-    qDebug() << "Graph: " << "V: " <<  global_v << "; E: " << global_e;
-    vfile.close();
+    qDebug() << "Graph: " << "V: " <<  preset_v << "; E: " << preset_e;
     //READ E FILE
-    efile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream ein(&efile);
-    QList<QPair<quint32,quint32> > edge;
-    while (!ein.atEnd())
-    {
-        QStringList str = ein.readLine().split('\t');
-        bool ok;
-        quint32 v1 = str[0].toUInt(&ok), v2 = str[1].toUInt(&ok);
-        if (ok)
-        {
-            edge.append(qMakePair(v1,v2));
-        }
-    }
-    efile.close();
+    std::vector<QPair<quint32,quint32> > edge;
+    edge.reserve(preset_e);
+    quint64 skipped;
+    if (!EdgeListParser::read_file_parallel(e_file, &edge, skipped))
+        return;
+    if (skipped > 0)
+        qDebug() << "- Skipped" << skipped << "Malformed Lines In Edge File";
     qDebug() << "Generating Vertex and Edges ...";
     // adding ve edge independent of global file
-    for (int i = 0; i < global_v; i++ )
+    for (quint32 i = 0; i < preset_v; i++)
     {
-        Vertex * v = new Vertex;
+        Vertex * v = new Vertex(this);
         v->setIndex(i);
         myVertexList.append(v);
     }
-
-    for (int i = 0; i < edge.size(); i++)
-    {
-        QPair<int,int> e = edge[i];
-        int v = e.first, u = e.second;
-        Vertex * from = myVertexList[v];
-        Vertex * to = myVertexList[u];
-        Edge * newe = new Edge(from,to,i/2);
-        myEdgeList.append(newe);
-    }
+    generate_edges(edge);
 
 
     bool fit = false;
-    if (myVertexList.size() == global_v && myEdgeList.size() == global_e)
+    if (quint32(myVertexList.size()) == preset_v && myEdges.size() == preset_e)
         fit = true;
     qDebug() << "Check Sum" << fit;
     if (fit)
@@ -344,12 +293,81 @@ void Graph::read_simple_edge(QString dirPath)
     }
     else
     {
-        qDebug() << "Preset V: " << global_v << "; E: " << global_e;
-        qDebug() << "Load V: " << myVertexList.size() << "; E: " << myEdgeList.size();
+        qDebug() << "Preset V: " << preset_v << "; E: " << preset_e;
+        qDebug() << "Load V: " << myVertexList.size() << "; E: " << myEdges.size();
     }
 
 }
 
+/** Load a graph saved by save_binary_graph
+ * The adjacency is used straight from the mapped file, only the edge table
+ * and the vertices are built in memory
+ * @brief Graph::read_binary_graph
+ * @param filePath
+ * @return false if the file is not a valid binary graph
+ */
+bool Graph::read_binary_graph(QString filePath)
+{
+    BinaryGraphFile file;
+    if (!file.open(filePath))
+        return false;
+    preset_v = file.getNumberVertex();
+    preset_e = file.getNumberEdge();
+    qDebug() << "Graph (Binary): " << "V: " <<  preset_v << "; E: " << preset_e;
+    qDeleteAll(myVertexList);
+    myVertexList.clear();
+    quint32 n = file.getNumberVertex();
+    for (quint32 i = 0; i < n; i++)
+    {
+        Vertex * v = new Vertex(this);
+        v->setIndex(i);
+        myVertexList.append(v);
+    }
+    topology.adopt(preset_v, preset_e, file.offsets(), file.neighbours(),
+                   file.edgeIds(), file.twins(), file.getMapping());
+    myEdges.build(file.from(), file.to(), preset_e);
+    clusters.reset(preset_v);
+    triangles.build(topology);
+    graphIsReady = true;
+    return true;
+}
+
+/** Save the loaded graph in the binary format read by read_binary_graph
+ * @brief Graph::save_binary_graph
+ * @param fileName
+ * @return false if nothing was written
+ */
+bool Graph::save_binary_graph(QString fileName)
+{
+    if (myVertexList.size() == 0)
+    {
+        qDebug() << "No Graph Loaded! Not Saving Binary";
+        return false;
+    }
+    if (!BinaryGraphFile::write(fileName, topology, myEdges))
+        return false;
+    qDebug() << "Binary Graph Saved:" << fileName;
+    return true;
+}
+
+/** Convert the vertex_file/edge_file pair of dirPath to dirPath/graph.bin
+ * read_simple_edge picks the binary file up from then on, until the edge
+ * file is modified again
+ * @brief Graph::convert_simple_edge_to_binary
+ * @param dirPath
+ */
+void Graph::convert_simple_edge_to_binary(QString dirPath)
+{
+    QDir dir(dirPath);
+    read_simple_edge(dirPath);
+    if (!graphIsReady)
+    {
+        qDebug() << "Text Graph Not Loaded Correctly! Not Converting";
+        return;
+    }
+    save_binary_graph(dir.absoluteFilePath("graph.bin"));
+}
+
 /*
  * RECONNECT THE GRAPH AFTER AN AGGREGATION HAS BEEN DONE
  */
@@ -373,7 +391,7 @@ void Graph::random_aggregate()
         reConnectGraph();
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
 
     quint32 t = 0;
@@ -384,8 +402,7 @@ void Graph::random_aggregate()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         if (selected->is_vertex_absorbed() || selected->getParent() != 0)
         {
@@ -397,18 +414,17 @@ void Graph::random_aggregate()
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            std::uniform_int_distribution<quint32> distribution2(0,no_neighbour-1);
-            quint32 selected_edge_index = distribution2(generator);
-            Edge * e = selected->getEdge(selected_edge_index);
+            quint32 selected_edge_index = generator.bounded(no_neighbour);
+            quint32 e = selected->getEdge(selected_edge_index);
             Vertex * neighbour = selected->get_neighbour_fromEdge(e); //get the neighbour (not clean)
             hierarchy.append(qMakePair(neighbour->getIndex(), selected->getIndex()));
             selected->absorb_removeEdge(e);
-            players.removeOne(neighbour);
+            players.remove(neighbour);
             t++;
         }
     }
@@ -432,7 +448,7 @@ void Graph::random_aggregate_with_degree_comparison()
     }
 
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
     quint32 t = 0;
     QTime t0;
@@ -442,23 +458,21 @@ void Graph::random_aggregate_with_degree_comparison()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            std::uniform_int_distribution<quint32> distribution2(0,no_neighbour-1);
-            quint32 selected_edge_index = distribution2(generator);
-            Edge * e = selected->getEdge(selected_edge_index);
-            Vertex * neighbour = selected->get_neighbour_fromEdge(selected_edge_index); //get the neighbour (not clean)
+            quint32 selected_edge_index = generator.bounded(no_neighbour);
+            quint32 e = selected->getEdge(selected_edge_index);
+            Vertex * neighbour = selected->get_neighbour(selected_edge_index); //get the neighbour (not clean)
             Vertex * winner, * loser;
             quint32 selected_d = selected->getNumberEdge(), neighbour_d = neighbour->getNumberEdge();
             if (selected_d >= neighbour_d)
@@ -475,7 +489,7 @@ void Graph::random_aggregate_with_degree_comparison()
             //abosbr
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
             winner->absorb_removeEdge(e);
-            players.removeOne(loser);
+            players.remove(loser);
             t++;
         }
     }
@@ -504,7 +518,7 @@ void Graph::random_aggregate_with_weight_comparison()
     }
 
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
     quint32 t = 0;
     QTime t0;
@@ -514,24 +528,22 @@ void Graph::random_aggregate_with_weight_comparison()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
 
-            std::uniform_int_distribution<quint32> distribution2(0,no_neighbour-1);
-            quint32 selected_edge_index = distribution2(generator);
-            Edge * e = selected->getEdge(selected_edge_index);
-            Vertex * neighbour = selected->get_neighbour_fromEdge(selected_edge_index); //get the neighbour (not clean)
+            quint32 selected_edge_index = generator.bounded(no_neighbour);
+            quint32 e = selected->getEdge(selected_edge_index);
+            Vertex * neighbour = selected->get_neighbour(selected_edge_index); //get the neighbour (not clean)
             Vertex * winner, * loser;
             quint64 selected_w = selected->getWeight(), neighbour_w = neighbour->getWeight();
             if (selected_w >= neighbour_w)
@@ -546,7 +558,7 @@ void Graph::random_aggregate_with_weight_comparison()
             }
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
             winner->absorb_removeEdge(e);
-            players.removeOne(loser);
+            players.remove(loser);
             t++;
         }
     }
@@ -572,7 +584,8 @@ void Graph::random_aggregate_with_neighbour_initial_degree_bias()
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
+    NeighbourSampler sampler(this, NeighbourSampler::StaticWeight);
     QList<Vertex*> winners;
   //  QSequentialAnimationGroup * group_anim = new QSequentialAnimationGroup;
     quint32 t = 0;
@@ -583,25 +596,24 @@ void Graph::random_aggregate_with_neighbour_initial_degree_bias()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            Vertex * neighbour = selected->aggregate_get_degree_biased_neighbour();
-            Edge * e = selected->getEdgeFromVertex(neighbour);
+            quint32 e = sampler.sample(selected);
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
             //create the animation
             selected->absorb_removeEdge(e);
             hierarchy.append(qMakePair(neighbour->getIndex(), selected->getIndex()));
-            players.removeOne(neighbour);
+            players.remove(neighbour);
             t++;
         }
     }
@@ -623,7 +635,8 @@ void Graph::random_aggregate_with_neighbour_CURRENT_degree_bias()
         reConnectGraph();
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
+    NeighbourSampler sampler(this, NeighbourSampler::CurrentDegree);
     QList<Vertex*> winners;
 
     quint32 t = 0;
@@ -634,24 +647,23 @@ void Graph::random_aggregate_with_neighbour_CURRENT_degree_bias()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            Edge * e = selected->getDegreeProbabilisticEdge();
+            quint32 e = sampler.sample(selected);
             Vertex * neighbour = selected->get_neighbour_fromEdge(e);
             selected->absorb_removeEdge(e);
             hierarchy.append(qMakePair(neighbour->getIndex(), selected->getIndex()));
-            players.removeOne(neighbour);
+            players.remove(neighbour);
             t++;
         }
     }
@@ -674,7 +686,7 @@ void Graph::random_aggregate_highest_CURRENT_degree_neighbour()
         reConnectGraph();
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
    // QSequentialAnimationGroup * group_anim = new QSequentialAnimationGroup;
     quint32 t = 0;
@@ -685,20 +697,19 @@ void Graph::random_aggregate_highest_CURRENT_degree_neighbour()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            Edge * e = selected->getHighestDegreeNeighbour();
+            quint32 e = selected->getHighestDegreeNeighbour();
             Vertex * neighbour = selected->get_neighbour_fromEdge(e);
             quint32 dv = selected->getNumberEdge(), du = neighbour->getNumberEdge();
             Vertex * winner, * loser;
@@ -715,7 +726,7 @@ void Graph::random_aggregate_highest_CURRENT_degree_neighbour()
 
             winner->absorb_removeEdge(e);
             hierarchy.append(qMakePair(neighbour->getIndex(), selected->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
             t++;
         }
     }
@@ -742,8 +753,9 @@ void Graph::random_aggregate_with_minimum_weight_neighbour()
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
+    NeighbourDegreeView neighbour_list(this);
    // QSequentialAnimationGroup * group_anim = new QSequentialAnimationGroup;
     quint32 t = 0;
     QTime t0;
@@ -753,24 +765,28 @@ void Graph::random_aggregate_with_minimum_weight_neighbour()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            Edge * e = selected->getSmallestCurrentDegreeNeighbour();
+            quint32 e = neighbour_list.smallest(selected);
             Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            //every neighbour of the absorbed vertex loses one degree
+            QList<quint32> affected = neighbour->getNeighbourIndexes();
             selected->absorb_removeEdge(e);
             hierarchy.append(qMakePair(neighbour->getIndex(), selected->getIndex()));
-            players.removeOne(neighbour);
+            players.remove(neighbour);
+            neighbour_list.update(neighbour->getIndex());
+            for (int i = 0; i < affected.size(); i++)
+                neighbour_list.update(affected[i]);
             t++;
         }
     }
@@ -792,8 +808,14 @@ void Graph::random_aggregate_probabilistic_lowest_degree_neighbour_destructive()
         reConnectGraph();
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
+    //players weighted by their current degree
+    FenwickTree candidate;
+    candidate.reset(myVertexList.size());
+    for (int i = 0; i < myVertexList.size(); i++)
+        candidate.set(i, myVertexList.at(i)->getNumberEdge());
+    NeighbourDegreeView neighbour_list(this);
 
     quint32 t = 0;
     QTime t0;
@@ -801,46 +823,43 @@ void Graph::random_aggregate_probabilistic_lowest_degree_neighbour_destructive()
 
     while(!players.empty()) //start
     {
-        QList<Vertex*> ran_list;
-        for (int i = 0; i < players.size(); i++)
-        {
-            Vertex * v = players.at(i);
-            for (quint32 j = 0; j < v->getNumberEdge(); j++)
-                ran_list.append(v);
-        }
-        if (ran_list.size() == 0)
+        if (candidate.total() == 0)
         {
             quint32 size = players.size();
-            std::uniform_int_distribution<quint32> distribution(0,size-1);
-            quint32 selected_index = distribution(generator);
+            quint32 selected_index = generator.bounded(size);
             Vertex * selected = players.at(selected_index);
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
         }
         else
         {
-            quint64 size = ran_list.size();
-            std::uniform_int_distribution<quint64> distribution(0,size-1);
-            quint64 selected_index = distribution(generator);
-            Vertex * selected = ran_list.at(selected_index);
+            Vertex * selected = myVertexList.at(candidate.sample(generator));
             //get a neighbour
             quint64 no_neighbour = selected->getNumberEdge();
             if (no_neighbour == 0) // if there is no neighbour, declare a winner
             {
                 winners.append(selected);
-                players.removeOne(selected);
+                players.remove(selected);
             }
             else // else absorb
             {
-                Edge * e = selected->getSmallestCurrentDegreeNeighbour();
+                quint32 e = neighbour_list.smallest(selected);
                 Vertex * neighbour = selected->get_neighbour_fromEdge(e); //get the neighbour (not clean)
                 Vertex * winner, * loser;
                 winner = selected;
                 loser = neighbour;
                 hierarchy.append(qMakePair(winner->getIndex(), loser->getIndex()));
-
+                //every neighbour of the loser loses one degree
+                QList<quint32> affected = loser->getNeighbourIndexes();
                 winner->absorb_removeEdge(e);
-                players.removeOne(loser);
+                players.remove(loser);
+                candidate.set(loser->getIndex(), 0);
+                neighbour_list.update(loser->getIndex());
+                for (int i = 0; i < affected.size(); i++)
+                {
+                    candidate.set(affected[i], topology.getDegree(affected[i]));
+                    neighbour_list.update(affected[i]);
+                }
             }
         }
         t++;
@@ -869,59 +888,62 @@ void Graph::random_aggregate_probabilistic_candidate_with_minimum_weight_neighbo
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
 
     quint32 t = 0;
     QTime t0;
     t0.start();
 
+    //players weighted by w(v)
+    FenwickTree candidate;
+    candidate.reset(myVertexList.size());
+    for (int i = 0; i < myVertexList.size(); i++)
+        candidate.set(i, myVertexList.at(i)->getWeight());
+    NeighbourDegreeView neighbour_list(this);
+
     while(!players.empty()) //start
     {
         //select a vertex uniformly at random
-        QList<Vertex*> ran_list;
-        for (quint32 i = 0 ;i < players.size(); i++)
-        {
-            Vertex * v = players.at(i);
-            quint64 w = v->getWeight();
-            for (quint64 j = 0; j < w; j++)
-                ran_list.append(v);
-        }
-        if (ran_list.size() == 0)
+        if (candidate.total() == 0)
         {
             quint32 size = players.size();
-            std::uniform_int_distribution<quint32> distribution(0,size-1);
-            quint32 selected_index = distribution(generator);
+            quint32 selected_index = generator.bounded(size);
             Vertex * selected = players.at(selected_index);
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else
         {
-            quint64 size = ran_list.size();
-            std::uniform_int_distribution<quint64> distribution(0,size-1);
-            quint64 selected_index = distribution(generator);
-            Vertex * selected = ran_list.at(selected_index);
+            Vertex * selected = myVertexList.at(candidate.sample(generator));
             //get a neighbour
             quint32 no_neighbour = selected->getNumberEdge();
             if (no_neighbour == 0) // if there is no neighbour, declare a winner
             {
                 winners.append(selected);
-                players.removeOne(selected);
+                players.remove(selected);
+                candidate.set(selected->getIndex(), 0);
                 t++;
             }
             else // else absorb
             {
-                Edge * e = selected->getSmallestCurrentDegreeNeighbour();
+                quint32 e = neighbour_list.smallest(selected);
                 Vertex * neighbour = selected->get_neighbour_fromEdge(e); //get the neighbour (not clean)
                 Vertex * winner, * loser;
                 winner = selected;
                 loser = neighbour;
                 hierarchy.append(qMakePair(winner->getIndex(), loser->getIndex()));
+                //every neighbour of the loser loses one degree
+                QList<quint32> affected = loser->getNeighbourIndexes();
                 winner->absorb_removeEdge(e);
                 winner->setWeight(loser->getWeight() + winner->getWeight());
-                players.removeOne(loser);
+                players.remove(loser);
+                candidate.set(loser->getIndex(), 0);
+                candidate.set(winner->getIndex(), winner->getWeight());
+                neighbour_list.update(loser->getIndex());
+                for (int i = 0; i < affected.size(); i++)
+                    neighbour_list.update(affected[i]);
                 t++;
             }
         }
@@ -947,8 +969,15 @@ void Graph::random_aggregate_greedy_max_degree()
         reConnectGraph();
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
+    //players are keyed by d(v) + 1, removed vertices drop to key 0
+    BucketQueue ran_list;
+    QVector<quint32> key(myVertexList.size());
+    for (int i = 0; i < myVertexList.size(); i++)
+        key[i] = myVertexList.at(i)->getNumberEdge() + 1;
+    ran_list.build(key);
+    NeighbourDegreeView neighbour_list(this);
    // QSequentialAnimationGroup * group_anim = new QSequentialAnimationGroup;
     quint32 t = 0;
     QTime t0;
@@ -956,45 +985,34 @@ void Graph::random_aggregate_greedy_max_degree()
 
     while(!players.empty()) //start
     {
-        QList<Vertex*> ran_list;
-        quint32 max_d = 0;
-        for (int i = 0; i < players.size(); i++)
-        {
-            Vertex * v = players.at(i);
-            quint32 dv = v->getNumberEdge();
-            if (dv > max_d)
-            {
-                max_d = dv;
-                ran_list.clear();
-                ran_list.append(v);
-            }
-            else if (dv == max_d)
-            {
-                ran_list.append(v);
-            }
-        }
-
-        int size = ran_list.size();
-        std::uniform_int_distribution<int> distribution(0,size-1);
-        int selected_index = distribution(generator);
-        Vertex * selected = ran_list.at(selected_index);
+        Vertex * selected = myVertexList.at(ran_list.sample_max(generator));
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
+            ran_list.decrease_to(selected->getIndex(), 0);
         }
         else // else absorb
         {
-            Edge * e = selected->getSmallestCurrentDegreeNeighbour();
+            quint32 e = neighbour_list.smallest(selected);
             Vertex * neighbour = selected->get_neighbour_fromEdge(e); //get the neighbour (not clean)
             Vertex * winner, * loser;
             winner = selected;
             loser = neighbour;
             hierarchy.append(qMakePair(winner->getIndex(), loser->getIndex()));
+            //every neighbour of the loser loses one degree
+            QList<quint32> affected = loser->getNeighbourIndexes();
             winner->absorb_removeEdge(e);
-            players.removeOne(loser);
+            players.remove(loser);
+            ran_list.decrease_to(loser->getIndex(), 0);
+            neighbour_list.update(loser->getIndex());
+            for (int i = 0; i < affected.size(); i++)
+            {
+                ran_list.decrease_to(affected[i], topology.getDegree(affected[i]) + 1);
+                neighbour_list.update(affected[i]);
+            }
         }
 
         t++;
@@ -1022,8 +1040,14 @@ void Graph::random_aggregate_greedy_max_weight()
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
+    //players by weight, the random tag makes the top a uniform pick among ties
+    IndexedHeap ran_list;
+    ran_list.reset(myVertexList.size());
+    for (int i = 0; i < myVertexList.size(); i++)
+        ran_list.set(i, myVertexList.at(i)->getWeight(), generator());
+    NeighbourWeightHeap neighbour_list(this);
 
     quint32 t = 0;
     QTime t0;
@@ -1031,40 +1055,19 @@ void Graph::random_aggregate_greedy_max_weight()
 
     while(!players.empty()) //start
     {
-        //select a vertex uniformly at random
-        QList<Vertex*> ran_list;
-        quint64 max_w = 0;
-        for (int i = 0; i < players.size(); i++)
-        {
-            Vertex * v = players[i];
-            quint64 wv = v->getWeight();
-            if (wv > max_w)
-            {
-                max_w = wv;
-                ran_list.clear();
-                ran_list.append(v);
-            }
-            else if (wv == max_w)
-            {
-                ran_list.append(v);
-            }
-        }
-
-        int size = ran_list.size();
-        std::uniform_int_distribution<int> distribution(0,size-1);
-        int selected_index = distribution(generator);
-        Vertex * selected = ran_list.at(selected_index);
+        Vertex * selected = myVertexList.at(ran_list.top());
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
+            ran_list.remove(selected->getIndex());
             t++;
         }
         else // else absorb
         {
-            Edge * e = selected->getSmallestCurrentWeightNeighbour();
+            quint32 e = neighbour_list.lightest(selected);
             Vertex * neighbour = selected->get_neighbour_fromEdge(e); //get the neighbour (not clean)
             Vertex * winner, * loser;
             winner = selected;
@@ -1072,7 +1075,9 @@ void Graph::random_aggregate_greedy_max_weight()
             hierarchy.append(qMakePair(winner->getIndex(), loser->getIndex()));
             winner->absorb_removeEdge(e);
             winner->setWeight(loser->getWeight() + winner->getWeight());
-            players.removeOne(loser);
+            players.remove(loser);
+            ran_list.remove(loser->getIndex());
+            ran_list.set(winner->getIndex(), winner->getWeight(), generator());
             t++;
         }
 
@@ -1100,13 +1105,14 @@ void Graph::random_aggregate_with_highest_triangulated_vertex()
     {
         reConnectGraph();
     }
+    track_triangles();
     for (int i = 0; i < myVertexList.size(); i++)
     {
         Vertex * v = myVertexList.at(i);
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
    // QSequentialAnimationGroup * group_anim = new QSequentialAnimationGroup;
     quint32 t = 0;
@@ -1117,25 +1123,21 @@ void Graph::random_aggregate_with_highest_triangulated_vertex()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         //get a neighbour
         quint32 no_neighbour = selected->getNumberEdge();
         if (no_neighbour == 0) // if there is no neighbour, declare a winner
         {
             winners.append(selected);
-            players.removeOne(selected);
+            players.remove(selected);
             t++;
         }
         else // else absorb
         {
-            Edge * e = selected->getMostMutualVertex();
-            Vertex * neighbour, * winner, * loser;
-            if (e->toVertex() == selected)
-                neighbour = e->fromVertex();
-            else
-                neighbour = e->toVertex();
+            quint32 e = selected->getMostMutualVertex();
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            Vertex * winner, * loser;
 
             if (selected == neighbour)
             {   qDebug() << "BUG CHECK" << "SELECTED POINTER == NEIGHBOUR POINTER";
@@ -1154,7 +1156,7 @@ void Graph::random_aggregate_with_highest_triangulated_vertex()
             }
             winner->absorb_removeEdge(e);
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
             t++;
         }
     }
@@ -1178,8 +1180,9 @@ void Graph::random_aggregate_retain_vertex_using_triangulation()
     {
         reConnectGraph();
     }
+    track_triangles();
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     quint32 t = 0;
     QTime t0;
     t0.start();
@@ -1188,26 +1191,22 @@ void Graph::random_aggregate_retain_vertex_using_triangulation()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         if (selected->getNumberEdge() == 0)
-            players.removeOne(selected);
+            players.remove(selected);
         else
         {
-            Edge * e = selected->getMostMutualVertex();
-            Vertex * neighbour, * winner, * loser;
-            if (e->toVertex() == selected)
-                neighbour = e->fromVertex();
-            else
-                neighbour = e->toVertex();
+            quint32 e = selected->getMostMutualVertex();
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            Vertex * winner, * loser;
 
             winner = neighbour;
             loser = selected;
             //create the animation
             winner->absorb_retainEdge(e);
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
         }
         t++;
     }
@@ -1229,9 +1228,10 @@ void Graph::random_aggregate_retain_vertex_using_probabilistic_triangulation()
     {
         reConnectGraph();
     }
+    track_triangles();
 
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
     quint32 t = 0;
     QTime t0;
@@ -1241,25 +1241,21 @@ void Graph::random_aggregate_retain_vertex_using_probabilistic_triangulation()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
 
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         if (selected->getNumberEdge() == 0)
-            players.removeOne(selected);
+            players.remove(selected);
         else
         {
-            Edge * e = selected->getProbabilisticTriangulationCoeffVertex();
-            Vertex * neighbour, * winner, * loser;
-            if (e->toVertex() == selected)
-                neighbour = e->fromVertex();
-            else
-                neighbour = e->toVertex();
+            quint32 e = selected->getProbabilisticTriangulationCoeffVertex();
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            Vertex * winner, * loser;
             winner = neighbour;
             loser = selected;
             winner->absorb_retainEdge(e);
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
         }
         t++;
     }
@@ -1282,6 +1278,7 @@ void Graph::random_aggregate_retain_vertex_using_triangulation_times_weight()
     {
         reConnectGraph();
     }
+    track_triangles();
     for (int i = 0; i < myVertexList.size(); i++)
     {
         Vertex * v = myVertexList.at(i);
@@ -1289,7 +1286,7 @@ void Graph::random_aggregate_retain_vertex_using_triangulation_times_weight()
         v->setWeight(1);
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     QList<Vertex*> winners;
     quint32 t = 0;
     QTime t0;
@@ -1299,33 +1296,29 @@ void Graph::random_aggregate_retain_vertex_using_triangulation_times_weight()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
 
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         if (selected->getNumberEdge() == 0)
-            players.removeOne(selected);
+            players.remove(selected);
         else
         {
-            Edge * e = selected->getProbabilisticTriangulationAndWeightVertex();
-            if (e == 0)
+            quint32 e = selected->getProbabilisticTriangulationAndWeightVertex();
+            if (e == EdgeTable::NoEdge)
             {
                 selected->setParent(selected);
-                players.removeOne(selected);
+                players.remove(selected);
                 continue;
             }
-            Vertex * neighbour, * winner, * loser;
-            if (e->toVertex() == selected)
-                neighbour = e->fromVertex();
-            else
-                neighbour = e->toVertex();
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            Vertex * winner, * loser;
 
             winner = neighbour;
             loser = selected;
             //create the animation
             winner->absorb_retainEdge(e);
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
         }
         t++;
     }
@@ -1347,13 +1340,14 @@ void Graph::random_aggregate_retain_vertex_using_triangulation_of_cluster()
     {
         reConnectGraph();
     }
+    track_triangles();
     for (int i = 0; i < myVertexList.size(); i++)
     {
         Vertex * v = myVertexList.at(i);
         v->setWeight(v->getNumberEdge());
     }
     //initialise arrays
-    QList<Vertex*> players = myVertexList;
+    ActiveSet players(myVertexList);
     quint32 t = 0;
     QTime t0;
     t0.start();
@@ -1362,26 +1356,22 @@ void Graph::random_aggregate_retain_vertex_using_triangulation_of_cluster()
     {
         //select a vertex uniformly at random
         quint32 size = players.size();
-        std::uniform_int_distribution<quint32> distribution(0,size-1);
-        quint32 selected_index = distribution(generator);
+        quint32 selected_index = generator.bounded(size);
         Vertex * selected = players.at(selected_index);
         if (selected->getNumberEdge() == 0)
-            players.removeOne(selected);
+            players.remove(selected);
         else
         {
-            Edge * e = selected->getHighestTriangulateCluster();
-            Vertex * neighbour, * winner, * loser;
-            if (e->toVertex() == selected)
-                neighbour = e->fromVertex();
-            else
-                neighbour = e->toVertex();
+            quint32 e = selected->getHighestTriangulateCluster();
+            Vertex * neighbour = selected->get_neighbour_fromEdge(e);
+            Vertex * winner, * loser;
 
             winner = neighbour;
             loser = selected;
             //create the animation
             winner->absorb_retainEdge(e);
             hierarchy.append(qMakePair(loser->getIndex(), winner->getIndex()));
-            players.removeOne(loser);
+            players.remove(loser);
         }
         t++;
     }
@@ -1543,13 +1533,10 @@ void Graph::reindexing()
     QTextStream out(&file);
     //edge are Source Target Seperated by tab \t
     //begin writing edge
-    for (quint32 i = 0; i < myEdgeList.size(); i++)
+    for (quint32 i = 0; i < myEdges.size(); i++)
     {
-        Edge * e = myEdgeList.at(i);
-        Vertex * from = e->fromVertex();
-        Vertex * to = e->toVertex();
-        quint32 dumex_v = myVertexList.indexOf(from);
-        quint32 dumex_u = myVertexList.indexOf(to);
+        quint32 dumex_v = myEdges.getFrom(i);
+        quint32 dumex_u = myEdges.getTo(i);
         if (dumex_v == dumex_u)
         {
             qDebug() << "Error: Self Loop Edge";
@@ -1741,9 +1728,9 @@ void Graph::read_DUMEX_input(QString dirPath)
         qDebug() << "DIR NOT EXISTS! Terminating ...";
         return;
     }
-    globalDirPath = dirPath;
+    myDirPath = dirPath;
     QStringList filters;
-    filters << "*.txt";
+    filters << DecompressDevice::getNameFilters("*.txt");
     QFileInfoList file = dir.entryInfoList(filters);
     QString v_file, e_file, t_file;
     for (int i = 0; i < file.size(); i++)
@@ -1751,11 +1738,11 @@ void Graph::read_DUMEX_input(QString dirPath)
         QFileInfo f = file.at(i);
         QString name = f.fileName();
         if (name.contains("edge"))
-            e_file = f.absoluteFilePath();
+            e_file = DecompressDevice::prefer_plain(e_file, f.absoluteFilePath());
         else if (name.contains("vertex"))
-            v_file = f.absoluteFilePath();
+            v_file = DecompressDevice::prefer_plain(v_file, f.absoluteFilePath());
         else if (name.contains("truth"))
-            t_file = f.absoluteFilePath();
+            t_file = DecompressDevice::prefer_plain(t_file, f.absoluteFilePath());
         else
             qDebug() << "ERROR READING FILES: File not Found!";
     }
@@ -1769,36 +1756,22 @@ void Graph::read_DUMEX_input(QString dirPath)
         return;
     }
     //else
-    vfile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream vin(&vfile);
-    QStringList str = vin.readLine().split('\t');
-    bool load;
-    global_v = str[0].toUInt(&load);
-    global_e = str[1].toUInt(&load);
-    if (!load)
+    if (!EdgeListParser::read_header(v_file, preset_v, preset_e))
     {
         qDebug() << "ERROR LOADING V FILE";
         return;
     }
-    vfile.close();
     //READ E FILE
-    efile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream ein(&efile);
-    QList<QPair<quint32,quint32> > edge;
-    while (!ein.atEnd())
-    {
-        QStringList str = ein.readLine().split('\t');
-        bool ok;
-        quint32 v1 = str[0].toUInt(&ok), v2 = str[1].toUInt(&ok);
-        if (ok)
-        {
-            edge.append(qMakePair(v1,v2));
-        }
-    }
-    efile.close();
+    std::vector<QPair<quint32,quint32> > edge;
+    edge.reserve(preset_e);
+    EdgeListParser parser(&edge);
+    if (!parser.read_file(e_file))
+        return;
+    if (parser.getNumberSkipped() > 0)
+        qDebug() << "- Skipped" << parser.getNumberSkipped() << "Malformed Lines In Edge File";
 
     qDebug() << "FINISHED LOADING DUMEX_TEMPLATE GRAPH!";
-    qDebug() << "V:" << global_v << "; E:" << global_e;
+    qDebug() << "V:" << preset_v << "; E:" << preset_e;
     /*
     //reload original vertices
     vfile.open(QFile::ReadOnly | QFile::Text);
@@ -1830,25 +1803,18 @@ void Graph::read_DUMEX_input(QString dirPath)
     qDebug() << "FINISHED RELOAD SNAP INDICES!";
     */
     //create Vertex and Edge object DECAPREATED
-    for (quint32 i = 0; i < global_v; i++)
+    for (quint32 i = 0; i < preset_v; i++)
     {
-        Vertex * v = new Vertex;
+        Vertex * v = new Vertex(this);
         v->setIndex(i);
         myVertexList.append(v);
     }
-
-    for (quint32 i = 0; i < global_e; i++)
-    {
-        QPair<quint32,quint32> p = edge[i];
-        quint32 from = p.first, to = p.second;
-        Vertex * vfrom = myVertexList.at(from);
-        Vertex * vto = myVertexList.at(to);
-        Edge * e = new Edge(vfrom,vto,i);
-        myEdgeList.append(e);
-    }
+    if (edge.size() > preset_e)
+        edge.resize(preset_e);
+    generate_edges(edge);
     //check sum
     bool fit = false;
-    if (myVertexList.size() == global_v && myEdgeList.size() == global_e)
+    if (quint32(myVertexList.size()) == preset_v && myEdges.size() == preset_e)
         fit = true;
     qDebug() << "Check Sum" << fit;
     if(fit)
@@ -1856,9 +1822,10 @@ void Graph::read_DUMEX_input(QString dirPath)
         graphIsReady = true;
         qDebug() << "PREQUISITE: OK! READING TRUTH FILES";
         ground_truth_communities.clear();
-        QFile tfile(t_file);
-        tfile.open(QFile::ReadOnly | QFile::Text);
-        QTextStream tin(&tfile);
+        QScopedPointer<QIODevice> truth(DecompressDevice::open_file(t_file));
+        if (truth.isNull())
+            return;
+        QTextStream tin(truth.data());
         quint32 max = 0;
         while (!tin.atEnd())
         {
@@ -1891,7 +1858,7 @@ void Graph::read_DUMEX_input(QString dirPath)
             qDebug() << "OK!";
         }
         qDebug() << "FINISHED! Number of Comm: " << ground_truth_communities.size();
-        tfile.close();
+        truth->close();
         //check,
         QSet<quint32> clustered;
 
@@ -1941,23 +1908,23 @@ void Graph::large_graph_parse_result()
     }
     QList<QList<quint32> > C;
     //qDebug() << "C: " << centroids.size();
+    //resolve every vertex to the cluster of its centroid
+    QVector<int> slot(myVertexList.size(), -1);
+    QVector<QList<quint32> > members(centroids.size());
     for (int i = 0; i < centroids.size(); i++)
+        slot[clusters.find(centroids.at(i)->getIndex())] = i;
+    for (int i = 0; i < myVertexList.size(); i++)
     {
-        QList<quint32> c;
-        Vertex * v = centroids.at(i);
-        quint32 v_i = v->getIndex();
-        if (!large_excluded.contains(v_i))
-            c.append(v_i);
-        QList<Vertex*> absorbed = v->getAbsorbedList();
-        for (int j = 0; j < absorbed.size(); j++)
-        {
-            quint32 u_i = absorbed[j]->getIndex();
-            if (!large_excluded.contains(u_i))
-                c.append(u_i); //get the SNAP index
-        }
+        quint32 u_i = myVertexList.at(i)->getIndex();
+        int s = slot[clusters.find(u_i)];
         //exclude vertices that is not included in SNAP
-        if (c.size() > 0)
-            C.append(c);
+        if (s != -1 && !large_excluded.contains(u_i))
+            members[s].append(u_i); //get the SNAP index
+    }
+    for (int i = 0; i < members.size(); i++)
+    {
+        if (members[i].size() > 0)
+            C.append(members[i]);
     }
     /** Prepare data for indicies matching
       */
@@ -1969,7 +1936,6 @@ void Graph::large_graph_parse_result()
     {
         qDebug() << "GROUND TRUTH COMMUNITIES HAS NOT BEEN LOADED OR GRAPH HAS NOT BEEN CLUSTERED";
         qDebug() << "Only Modularity Can Be Calculated:";
-        LARGE_reload_edges();
         qDebug() << "Q: " << LARGE_compute_modularity();
     }
     else
@@ -2041,7 +2007,7 @@ void Graph::large_parse_retain_result()
 void Graph::print_result_stats()
 {
     qDebug() << "- Writing Log ...";
-    QString logPath = globalDirPath + "/log.txt";
+    QString logPath = myDirPath + "/log.txt";
     QFile outFile(logPath);
     outFile.open(QIODevice::WriteOnly | QIODevice::Append);
     QTextStream out(&outFile);
@@ -2125,7 +2091,6 @@ void Graph::LARGE_compute_cluster_matching(quint32 n)
            // JAcc = LARGE_compute_Jaccard_index(),
            // Newman = LARGE_compute_Newman_fraction_of_classified();
     //calculate modularity
-    LARGE_reload_edges();
     double Q = LARGE_compute_modularity();
     qDebug() << "Q:" << Q;
     return;
@@ -2305,35 +2270,28 @@ double Graph::calAdRand(QList<quint64> param)
 }
 
 /** Calculate the Clustering Coeffficient, which is the average over all v
- * Watts Algorithm
+ * Watts Algorithm, c(v) = tri(v) / (d(v)(d(v)-1)/2) and 0 when d(v) < 2
  * @brief Graph::cal_average_clustering_coefficient
  * @return
  */
 double Graph::cal_average_clustering_coefficient()
 {
-    typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS> NormalGraph;
-    NormalGraph g;
-    for (int i = 0; i < myVertexList.size(); i++)
-    {
-        boost::add_vertex(g);
-    }
-    for(int i = 0;i  < myEdgeList.size(); i++)
-    {
-        Edge * e = myEdgeList.at(i);
-        int from = e->fromVertex()->getIndex(), to = e->toVertex()->getIndex();
-        boost::add_edge(from,to,g);
-    }
-    // Compute the clustering coefficients of each vertex in the graph
-    // and the mean clustering coefficient which is returned from the
-    // computation.
-    typedef boost::exterior_vertex_property<NormalGraph, float> ClusteringProperty;
-    typedef ClusteringProperty::container_type ClusteringContainer;
-    typedef ClusteringProperty::map_type ClusteringMap;
+    return cal_graph_stats().getAverageClusteringCoefficient();
+}
 
-    ClusteringContainer coefs(boost::num_vertices(g));
-    ClusteringMap cm(coefs, g);
-    double cc = boost::all_clustering_coefficients(g, cm);
-    return cc;
+/** Clustering coefficient, transitivity, degree histogram and components
+ * of the loaded graph in a single parallel pass, straight from the adjacency
+ * and the triangle counts computed at load time
+ * @brief Graph::cal_graph_stats
+ * @return
+ */
+GraphStats Graph::cal_graph_stats()
+{
+    if (!triangles.isBuilt())
+        triangles.build(topology);
+    GraphStats stats;
+    stats.compute(topology, triangles);
+    return stats;
 }
 
 
@@ -2347,7 +2305,13 @@ void Graph::LARGE_reset()
     {
         myVertexList[i]->resetClusterRelevant();
     }
-    myEdgeList.clear();
+    topology.reset();
+    myEdges.revive_all();
+    clusters.reset(myVertexList.size());
+    triangles.stop();
+    //next run, next stream
+    run_id++;
+    generator.setKey(seed, run_id, thread_id);
     hierarchy.clear();
     centroids.clear();
     large_result.clear();
@@ -2355,145 +2319,26 @@ void Graph::LARGE_reset()
 }
 
 /** Reload
+ * The loaded topology is kept in memory, only the overlay of the previous
+ * run is dropped, so nothing is read from disk again
  * @brief Graph::LARGE_reload
  */
 bool Graph::LARGE_reload()
 {
     qDebug() << "RELOADING";
     LARGE_reset();
-    if (globalDirPath.size() == 0)
+    if (myVertexList.empty() || topology.getNumberVertex() != (quint32) myVertexList.size())
     {
-        qDebug() << "GLOBAL DIR PATH HAS NOT BEEN SET!";
+        qDebug() << "GRAPH HAS NOT BEEN LOADED!";
         return false;
     }
-    //read edge only
-    myEdgeList.clear();
-    if (no_run == 0 )
-        LARGE_reload_edges();
-    else
-    {
+    if (no_run > 0)
         qDebug() << "- ** Reaggregation Detected! Following are results for super graph...";
-        LARGE_reload_superEdges();
-    }
 
     graphIsReady = true;
     return graphIsReady;
 }
 
-/** RELOAD EDGES ONLY
- * This is good enough
- * @brief Graph::LARGE_reload_edges
- */
-void Graph::LARGE_reload_edges()
-{
-    qDebug() << "- Reloading Edges ...";
-    QDir dir(globalDirPath);
-    QStringList filters;
-    filters << "*.txt";
-    QFileInfoList file = dir.entryInfoList(filters);
-    QString e_file;
-    for (int i = 0; i < file.size(); i++)
-    {
-        QFileInfo f = file.at(i);
-        QString name = f.fileName();
-        if (name.contains("edge"))
-            e_file = f.absoluteFilePath();
-    }
-
-    //Parsing
-    QFile efile(e_file);
-    if (!efile.exists())
-    {
-        qDebug() << "FILE NOT FOUND! Recheck! Terminating ...";
-        return;
-    }
-    //else
-    efile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream ein(&efile);
-    QList<QPair<quint32,quint32> > edge;
-    ein.readLine(); //skip first line
-    while (!ein.atEnd())
-    {
-        QStringList str = ein.readLine().split('\t');
-        bool ok;
-        quint32 v1 = str[0].toUInt(&ok), v2 = str[1].toUInt(&ok);
-        if (ok)
-        {
-            edge.append(qMakePair(v1,v2));
-        }
-    }
-    efile.close();
-    //reload original vertices
-    //create Vertex and Edge object
-    qDebug() << "- Now Loading Edges ...";
-    for (int i = 0; i < edge.size(); i++)
-    {
-        QPair<quint32,quint32> p = edge[i];
-        quint32 from = p.first, to = p.second;
-        Vertex * vfrom = myVertexList.at(from);
-        Vertex * vto = myVertexList.at(to);
-        Edge * e = new Edge(vfrom,vto,i);
-        myEdgeList.append(e);
-    }
-    edge.clear();
-}
-
-void Graph::LARGE_reload_superEdges()
-{
-    qDebug() << "- Reloading Edges ...";
-    QDir dir(globalDirPath);
-    QStringList filters;
-    filters << "*.txt";
-    QFileInfoList file = dir.entryInfoList(filters);
-    QString e_file;
-    for (int i = 0; i < file.size(); i++)
-    {
-        QFileInfo f = file.at(i);
-        QString name = f.fileName();
-        if (name.contains("superGraph"))
-            e_file = f.absoluteFilePath();
-    }
-
-    //Parsing
-    QFile efile(e_file);
-    if (!efile.exists())
-    {
-        qDebug() << "FILE NOT FOUND! Recheck! Terminating ...";
-        return;
-    }
-    //else
-    efile.open(QFile::ReadOnly | QFile::Text);
-    QTextStream ein(&efile);
-    QList<QPair<quint32,quint32> > edge;
-    ein.readLine(); //skip first line
-    while (!ein.atEnd())
-    {
-        QStringList str = ein.readLine().split('\t');
-        bool ok;
-        quint32 v1 = str[0].toUInt(&ok), v2 = str[1].toUInt(&ok);
-        if (ok)
-        {
-            edge.append(qMakePair(v1,v2));
-        }
-    }
-    efile.close();
-    //reload original vertices
-    //create Vertex and Edge object
-    qDebug() << "- Now Loading Edges ...";
-    for (int i = 0; i < edge.size(); i++)
-    {
-        QPair<quint32,quint32> p = edge[i];
-        quint32 from = p.first, to = p.second;
-        Vertex * vfrom = myVertexList.at(from);
-        Vertex * vto = myVertexList.at(to);
-        Edge * e = new Edge(vfrom,vto,i);
-        myEdgeList.append(e);
-    }
-    edge.clear();
-}
-
-
-
 /** Rerun
  * @brief Graph::LARGE_rerun
  */
@@ -2672,11 +2517,11 @@ void Graph::run_aggregation_on_selection(int n)
  */
 double Graph::LARGE_compute_modularity()
 {
-    //firstly reload the edges
-    if (global_e == 0)
+    //modularity is measured on the loaded graph, not on what the run left
+    if (preset_e == 0)
     {
         qDebug() << "Graph Has Not Been Initialised Properly: E = 0 ! Trying to Probe Again;";
-        global_e = myEdgeList.size();
+        preset_e = myEdges.size();
     }
     //go through result
     double Q = 0.0;
@@ -2688,12 +2533,11 @@ double Graph::LARGE_compute_modularity()
         for (int j = 0; j < c.size(); j++)
         {
             quint32 id = c[j];
-            Vertex * v = myVertexList.at(id);
-            QList<Edge*> adj = v->getAllEdge();
-            for (int k = 0; k < adj.size(); k++)
+            const quint32 * adj = topology.initialNeighbours(id);
+            quint32 d = topology.getInitialDegree(id);
+            for (quint32 k = 0; k < d; k++)
             {
-                Vertex * other = v->get_neighbour_fromEdge(adj[k]);
-                quint32 other_id = other->getIndex();
+                quint32 other_id = adj[k];
                 if (vi.contains(other_id))
                     intra++;
                 else
@@ -2701,7 +2545,7 @@ double Graph::LARGE_compute_modularity()
             }
         }
 
-        quint64 m = 2*global_e;
+        quint64 m = 2*preset_e;
         double e = (double)intra/m;
         double a = (double)(intra + inter)/m;
         double Qi = e - qPow(a,2);
@@ -2724,16 +2568,12 @@ void Graph::PostAgg_generate_super_vertex()
         qDebug() << "- Aggregation Result is Empty! Terminating ...";
         return;
     }
-    if (myEdgeList.empty()) //reload edge if this is not retain type
-    {
-        LARGE_reload_edges();
-    }
     //first create super vertices
     QList<Vertex*> superV;
     QMap<int,Vertex*> superMap; //map from old vertex to new vertex
     for(int i = 0; i < large_result.size(); i++)
     {
-        Vertex * v = new Vertex;
+        Vertex * v = new Vertex(this);
         v->setIndex(superV.size());
         superV.append(v);
         QList<quint32> c = large_result[i];
@@ -2744,49 +2584,39 @@ void Graph::PostAgg_generate_super_vertex()
         }
     }
 
-    QList<Edge*> superE;
-    QList<QPair<quint32,quint32> > newE;
+    //every inter-cluster edge, repeated super edges are dropped in bulk by generate_edges
+    std::vector<QPair<quint32,quint32> > superE;
+    superE.reserve(myEdges.size());
     //conencting super vertices
-    for(int i = 0; i < myEdgeList.size(); i++)
+    for (quint32 i = 0; i < myEdges.size(); i++)
     {
-        quint32 from = myEdgeList[i]->fromVertex()->getIndex(), to = myEdgeList[i]->toVertex()->getIndex();
+        quint32 from = myVertexList.at(myEdges.getFrom(i))->getIndex(), to = myVertexList.at(myEdges.getTo(i))->getIndex();
         if (!superMap.contains(from) || !superMap.contains(to))
         {
             qDebug() << "- Post Aggregation Error! Vertices Has Not Been Assigned To A Super Vertex";
             qDebug() << "- Terminating ...";
             return;
         }
-        Vertex * superFrom = superMap.value(from);
-        Vertex * superTo = superMap.value(to);
-        if (superFrom->getIndex() == superTo->getIndex()){
-        }
-        else
-        {
-            QPair<quint32,quint32> s = qMakePair(superFrom->getIndex(), superTo->getIndex());
-            QPair<quint32,quint32> r_s = qMakePair(superTo->getIndex(), superFrom->getIndex());
-            if (!newE.contains(s) && !newE.contains(r_s))
-            {
-                newE.append(s);
-                newE.append(r_s);
-                Edge * e = new Edge(superFrom,superTo,superE.size());
-                superE.append(e);
-            }
-        }
+        quint32 superFrom = superMap.value(from)->getIndex();
+        quint32 superTo = superMap.value(to)->getIndex();
+        if (superFrom != superTo)
+            superE.push_back(qMakePair(superFrom, superTo));
     }
 
     //clearing the old list
     for (int i = 0; i < myVertexList.size(); i++)
         delete myVertexList[i];
     myVertexList = superV;
-    myEdgeList = superE;
+    generate_edges(superE);
     qDebug() << "- Post Aggregation Finished! After collapsing: SuperV: " << myVertexList.size()
-             << "SuperE: " << myEdgeList.size();
-    global_e = myEdgeList.size();
-    global_v = myVertexList.size();
+             << "SuperE: " << myEdges.size();
+    preset_e = myEdges.size();
+    preset_v = myVertexList.size();
     no_run++;
-    qDebug() << "After Clustering Coefficient:" << cal_average_clustering_coefficient();
+    qDebug() << "After Aggregation Graph Stats:";
+    cal_graph_stats().print();
     qDebug() << "Saving to the dir";
-    save_current_run_as_edge_file(QString(globalDirPath + "superGraph" + QString::number(no_run) + ".txt"));
+    save_current_run_as_edge_file(QString(myDirPath + "superGraph" + QString::number(no_run) + ".txt"));
 }
 
 /** Save the current run to stich back later
@@ -2796,3 +2626,70 @@ void Graph::save_current_clusters()
 {
 
 }
+
+/** Fill the edge table and the CSR adjacency from an edge list
+ * Repeated edges are dropped while the adjacency is built, the remaining
+ * ones are numbered in list order
+ * @brief Graph::generate_edges
+ * @param edge
+ */
+void Graph::generate_edges(const std::vector<QPair<quint32,quint32> > &edge)
+{
+    std::vector<QPair<quint32,quint32> > unique;
+    if (!topology.build(myVertexList.size(), edge, unique))
+    {
+        topology.build(myVertexList.size(), std::vector<QPair<quint32,quint32> >(), unique);
+        myEdges.clear();
+        clusters.reset(myVertexList.size());
+        triangles.clear();
+        return;
+    }
+    quint64 duplicate = edge.size() - unique.size();
+    if (duplicate > 0)
+        qDebug() << "- Skipped" << duplicate << "Duplicate Edges";
+    myEdges.build(unique);
+    clusters.reset(myVertexList.size());
+    triangles.build(topology);
+}
+
+CSRGraph *Graph::getTopology()
+{
+    return &topology;
+}
+
+Vertex *Graph::getVertex(const quint32 &index) const
+{
+    return myVertexList.at(index);
+}
+
+EdgeTable *Graph::getEdgeTable()
+{
+    return &myEdges;
+}
+
+/** Cluster membership of the current run, one disjoint set per cluster
+ * @brief Graph::getClusters
+ */
+UnionFind *Graph::getClusters()
+{
+    return &clusters;
+}
+
+/** Triangle count of every edge, only current while a run tracks it
+ * @brief Graph::getTriangles
+ */
+TriangleSupport *Graph::getTriangles()
+{
+    return &triangles;
+}
+
+/** Let the current run read triangle counts from the cache
+ * The counts are normally computed when the graph is loaded
+ * @brief Graph::track_triangles
+ */
+void Graph::track_triangles()
+{
+    if (!triangles.isBuilt())
+        triangles.build(topology);
+    triangles.track();
+}
@@ -4,20 +4,46 @@
 #include <QtCore>
 #include <QTimer>
 
+#include <random>
+#include <vector>
+
 #include "vertex.h"
-#include "edge.h"
+#include "edgetable.h"
+#include "csrgraph.h"
+#include "activeset.h"
+#include "unionfind.h"
+#include "neighboursampler.h"
+#include "fenwicktree.h"
+#include "bucketqueue.h"
+#include "indexedheap.h"
+#include "neighbourweightheap.h"
+#include "neighbourdegreeview.h"
+#include "randomstream.h"
+#include "trianglesupport.h"
+#include "graphstats.h"
+#include "binarygraphfile.h"
+#include "edgelistparser.h"
+#include "gmlreader.h"
+#include "decompressdevice.h"
 
 
 class Graph
 {
 public:
     Graph();
+    ~Graph();
+    void setSeed(const quint64 &seed, const quint32 &thread = 0);
+    RandomStream & getGenerator();
+    void share_loaded_graph(const Graph &source);
 
     void read_GML_file(QString filePath);
     void save_edge_file_from_GML();
     void save_current_run_as_edge_file(QString fileName);
     void read_DUMEX_input(QString dirPath);
     void read_simple_edge(QString dirPath);
+    bool read_binary_graph(QString filePath);
+    bool save_binary_graph(QString fileName);
+    void convert_simple_edge_to_binary(QString dirPath);
     void load_ground_truth_communities();
     void read_large_graph_with_ground_truth_communities();
     //investigate bridges
@@ -27,6 +53,7 @@ public:
     void run_aggregation_on_selection(int n);
     //stats
     double cal_average_clustering_coefficient();
+    GraphStats cal_graph_stats();
     //aggregation
     void random_aggregate();
     void random_aggregate_with_degree_comparison();
@@ -50,6 +77,12 @@ public:
     //post aggregation
     void PostAgg_generate_super_vertex();
     void PostAgg_adjust_variables();
+    //adjacency access for Vertex
+    CSRGraph * getTopology();
+    Vertex * getVertex(const quint32 &index) const;
+    EdgeTable * getEdgeTable();
+    UnionFind * getClusters();
+    TriangleSupport * getTriangles();
 
 private:
     void read_ground_truth_communities();
@@ -70,9 +103,9 @@ private:
     double LARGE_compute_modularity();
     void LARGE_reset();
     bool LARGE_reload();
-    void LARGE_reload_edges();
-    void LARGE_reload_superEdges();
+    void track_triangles();
     void save_current_clusters();
+    void generate_edges(const std::vector<QPair<quint32,quint32> > &edge);
 
     quint32 count_unique_element();
     quint64 calA(QList<quint64> param);
@@ -83,10 +116,22 @@ private:
 
     //
     QString GMLpath;
+    QString myDirPath;
+    quint32 preset_e;
+    quint32 preset_v;
+    int no_run;
+    //every run draws from the stream (seed, run_id, thread_id)
+    quint64 seed;
+    quint32 run_id;
+    quint32 thread_id;
+    RandomStream generator;
     //
 
     QList<Vertex*> myVertexList;
-    QList<Edge*> myEdgeList;
+    EdgeTable myEdges;
+    CSRGraph topology;
+    UnionFind clusters;
+    TriangleSupport triangles;
     QList<Vertex*> centroids;
     //
     QList<QList<quint32> > ground_truth_communities;
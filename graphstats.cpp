@@ -0,0 +1,142 @@
+#include "graphstats.h"
+#include "csrgraph.h"
+#include "trianglesupport.h"
+#include "unionfind.h"
+#include "parallelrange.h"
+
+#include <QDebug>
+
+#include <algorithm>
+#include <utility>
+
+GraphStats::GraphStats()
+{
+    averageClusteringCoefficient = 0;
+    transitivity = 0;
+    noOfComponent = 0;
+}
+
+/** Everything at once over the base adjacency of g
+ * @brief GraphStats::compute
+ * @param g
+ * @param t per vertex triangles of g
+ */
+void GraphStats::compute(const CSRGraph &g, const TriangleSupport &t)
+{
+    quint32 n = g.getNumberVertex();
+    struct Partial
+    {
+        double ccSum;
+        quint64 triangle;
+        quint64 triple;
+        QVector<quint64> histogram;
+    };
+    quint32 noOfThread = ParallelRange::getNumberThread(n, ChunkSize);
+    QVector<Partial> partial(noOfThread);
+    for (quint32 i = 0; i < noOfThread; i++)
+    {
+        partial[i].ccSum = 0;
+        partial[i].triangle = 0;
+        partial[i].triple = 0;
+    }
+    ParallelRange::run(n, ChunkSize, [&](quint32 thread, quint32 begin, quint32 end)
+    {
+        Partial &p = partial[thread];
+        for (quint32 v = begin; v < end; v++)
+        {
+            const quint32 * adj = g.initialNeighbours(v);
+            quint32 d = g.getInitialDegree(v);
+            std::pair<const quint32 *, const quint32 *> loop = std::equal_range(adj, adj + d, v);
+            quint32 k = d - (loop.second - loop.first);
+            if (k >= (quint32) p.histogram.size())
+                p.histogram.resize(k + 1);
+            p.histogram[k]++;
+            if (k < 2)
+                continue;
+            quint64 tri = t.getVertexTriangles(v);
+            quint64 pairs = quint64(k) * (k - 1) / 2;
+            p.ccSum += double(tri) / pairs;
+            p.triangle += tri;
+            p.triple += pairs;
+        }
+    });
+
+    double ccSum = 0;
+    quint64 triangle = 0, triple = 0;
+    degreeHistogram.clear();
+    for (quint32 i = 0; i < noOfThread; i++)
+    {
+        const Partial &p = partial.at(i);
+        ccSum += p.ccSum;
+        triangle += p.triangle;
+        triple += p.triple;
+        if (p.histogram.size() > degreeHistogram.size())
+            degreeHistogram.resize(p.histogram.size());
+        for (int k = 0; k < p.histogram.size(); k++)
+            degreeHistogram[k] += p.histogram.at(k);
+    }
+    averageClusteringCoefficient = n > 0 ? ccSum / n : 0;
+    //every triangle is counted once at each of its three corners
+    transitivity = triple > 0 ? double(triangle) / triple : 0;
+
+    UnionFind components;
+    components.reset(n);
+    noOfComponent = n;
+    for (quint32 v = 0; v < n; v++)
+    {
+        const quint32 * adj = g.initialNeighbours(v);
+        quint32 d = g.getInitialDegree(v);
+        for (quint32 i = 0; i < d; i++)
+        {
+            if (adj[i] <= v)
+                continue;
+            if (components.find(v) != components.find(adj[i]))
+            {
+                components.unite(v, adj[i]);
+                noOfComponent--;
+            }
+        }
+    }
+}
+
+void GraphStats::print() const
+{
+    quint64 vertex = 0, slot = 0;
+    for (int k = 0; k < degreeHistogram.size(); k++)
+    {
+        vertex += degreeHistogram.at(k);
+        slot += degreeHistogram.at(k) * k;
+    }
+    qDebug() << "- Clustering Coefficient:" << averageClusteringCoefficient
+             << "; Transitivity:" << transitivity
+             << "; Components:" << noOfComponent;
+    qDebug() << "- Max Degree:" << (degreeHistogram.isEmpty() ? 0 : degreeHistogram.size() - 1)
+             << "; Average Degree:" << (vertex > 0 ? double(slot) / vertex : 0.0)
+             << "; Isolated:" << (degreeHistogram.isEmpty() ? 0 : degreeHistogram.at(0));
+}
+
+double GraphStats::getAverageClusteringCoefficient() const
+{
+    return averageClusteringCoefficient;
+}
+
+/** 3 x triangles / connected triples
+ * @brief GraphStats::getTransitivity
+ */
+double GraphStats::getTransitivity() const
+{
+    return transitivity;
+}
+
+/** Number of vertices of each degree, index k holds degree k
+ * @brief GraphStats::getDegreeHistogram
+ */
+const QVector<quint64> &GraphStats::getDegreeHistogram() const
+{
+    return degreeHistogram;
+}
+
+quint32 GraphStats::getNumberComponent() const
+{
+    return noOfComponent;
+}
@@ -0,0 +1,38 @@
+#ifndef GRAPHSTATS_H
+#define GRAPHSTATS_H
+
+#include <QtGlobal>
+#include <QVector>
+
+class CSRGraph;
+class TriangleSupport;
+
+/** Summary statistics of the loaded graph, computed in one pass
+ * Works on the CSR adjacency and the per vertex triangle counts in place.
+ * The per vertex part (clustering coefficient, connected triples, degree
+ * histogram) is split over threads with per-thread partial results, the
+ * components come from a union-find over the edges. Self loops are ignored.
+ */
+class GraphStats
+{
+public:
+    GraphStats();
+
+    void compute(const CSRGraph &g, const TriangleSupport &t);
+    void print() const;
+
+    double getAverageClusteringCoefficient() const;
+    double getTransitivity() const;
+    const QVector<quint64> & getDegreeHistogram() const;
+    quint32 getNumberComponent() const;
+
+    enum { ChunkSize = 4096 };
+
+private:
+    double averageClusteringCoefficient;
+    double transitivity;
+    QVector<quint64> degreeHistogram;
+    quint32 noOfComponent;
+};
+
+#endif // GRAPHSTATS_H
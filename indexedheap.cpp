@@ -0,0 +1,117 @@
+#include "indexedheap.h"
+
+const quint32 IndexedHeap::NotInHeap;
+
+IndexedHeap::IndexedHeap()
+{
+}
+
+/** Room for n items, the heap starts empty
+ * @brief IndexedHeap::reset
+ * @param n
+ */
+void IndexedHeap::reset(const quint32 &n)
+{
+    heap.clear();
+    heap.reserve(n);
+    position.fill(NotInHeap, n);
+    myKey.fill(0, n);
+    myTag.fill(0, n);
+}
+
+bool IndexedHeap::empty() const
+{
+    return heap.isEmpty();
+}
+
+bool IndexedHeap::contains(const quint32 &i) const
+{
+    return position[i] != NotInHeap;
+}
+
+/** Insert i or move it to its new key
+ * @brief IndexedHeap::set
+ * @param i
+ * @param key
+ * @param tag tie breaker among equal keys
+ */
+void IndexedHeap::set(const quint32 &i, const quint64 &key, const quint32 &tag)
+{
+    myKey[i] = key;
+    myTag[i] = tag;
+    if (!contains(i))
+    {
+        heap.append(i);
+        position[i] = heap.size() - 1;
+    }
+    sift_up(position[i]);
+    sift_down(position[i]);
+}
+
+void IndexedHeap::remove(const quint32 &i)
+{
+    if (!contains(i))
+        return;
+    quint32 slot = position[i];
+    quint32 last = heap.last();
+    heap.removeLast();
+    position[i] = NotInHeap;
+    if (last == i)
+        return;
+    place(slot, last);
+    sift_up(slot);
+    sift_down(position[last]);
+}
+
+quint32 IndexedHeap::top() const
+{
+    return heap.at(0);
+}
+
+bool IndexedHeap::above(const quint32 &a, const quint32 &b) const
+{
+    if (myKey[a] != myKey[b])
+        return myKey[a] > myKey[b];
+    if (myTag[a] != myTag[b])
+        return myTag[a] > myTag[b];
+    return a < b;
+}
+
+void IndexedHeap::place(const quint32 &slot, const quint32 &i)
+{
+    heap[slot] = i;
+    position[i] = slot;
+}
+
+void IndexedHeap::sift_up(quint32 slot)
+{
+    quint32 i = heap[slot];
+    while (slot > 0)
+    {
+        quint32 parent = (slot - 1) / 2;
+        if (!above(i, heap[parent]))
+            break;
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, i);
+}
+
+void IndexedHeap::sift_down(quint32 slot)
+{
+    quint32 i = heap[slot];
+    quint32 n = heap.size();
+    while (true)
+    {
+        quint32 child = 2 * slot + 1;
+        if (child >= n)
+            break;
+        if (child + 1 < n && above(heap[child + 1], heap[child]))
+            child++;
+        if (!above(heap[child], i))
+            break;
+        place(slot, heap[child]);
+        slot = child;
+    }
+    place(slot, i);
+}
@@ -0,0 +1,39 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/** Addressable binary max-heap over the items 0..n-1
+ * position[i] is the heap slot of item i, so a key can be raised, lowered
+ * or removed in O(log n). Items with the same key are ordered by a tag;
+ * giving every item a fresh random tag whenever its key changes makes the
+ * top a uniform pick among the items of maximum key.
+ */
+class IndexedHeap
+{
+public:
+    IndexedHeap();
+
+    void reset(const quint32 &n);
+    bool empty() const;
+    bool contains(const quint32 &i) const;
+    void set(const quint32 &i, const quint64 &key, const quint32 &tag);
+    void remove(const quint32 &i);
+    quint32 top() const;
+
+private:
+    static const quint32 NotInHeap = 0xFFFFFFFF;
+
+    bool above(const quint32 &a, const quint32 &b) const;
+    void place(const quint32 &slot, const quint32 &i);
+    void sift_up(quint32 slot);
+    void sift_down(quint32 slot);
+
+    QVector<quint32> heap;
+    QVector<quint32> position;
+    QVector<quint64> myKey;
+    QVector<quint32> myTag;
+};
+
+#endif // INDEXEDHEAP_H
@@ -41,7 +41,8 @@ int main(int argc, char *argv[])
     Graph G;
     QString filePath = "C:/Users/Dumex/Desktop/SocialNetworksCollection/cond-mat-2003/";
     G.read_simple_edge(filePath);
-    qDebug() << "Before Clustering Coefficient:" << G.cal_average_clustering_coefficient();
+    qDebug() << "Before Aggregation Graph Stats:";
+    G.cal_graph_stats().print();
     G.random_aggregate_retain_vertex_using_triangulation();
     G.PostAgg_generate_super_vertex();
     G.random_aggregate_retain_vertex_using_triangulation();
@@ -0,0 +1,95 @@
+#include "neighbourdegreeview.h"
+#include "graph.h"
+#include "vertex.h"
+#include "csrgraph.h"
+#include "edgetable.h"
+
+NeighbourDegreeView::NeighbourDegreeView(Graph *graph)
+{
+    myGraph = graph;
+    quint32 n = graph->getTopology()->getNumberVertex();
+    view.resize(n);
+    viewEdge.resize(n);
+    watcher.resize(n);
+    built.fill(false, n);
+}
+
+/** Live edge of v towards a neighbour of minimum current degree
+ * @brief NeighbourDegreeView::smallest
+ * @param v
+ * @return the edge index, EdgeTable::NoEdge if v has no live edge
+ */
+quint32 NeighbourDegreeView::smallest(Vertex *v)
+{
+    quint32 id = v->getIndex();
+    if (!built.testBit(id))
+        build(id);
+    BucketQueue &b = view[id];
+    if (b.getMinKey() == 0)
+    {
+        qDebug() << "Neighbour Degree View: Vertex" << id << "Has No Neighbour!";
+        return EdgeTable::NoEdge;
+    }
+    return viewEdge[id].at(b.sample_min(myGraph->getGenerator()));
+}
+
+/** Bring every view holding u in line with the current degree of u
+ * To be called for each vertex whose degree changed or that lost edges.
+ * Entries that can no longer change are dropped on the way: an item whose
+ * edge is detached stays at key 0, and a viewer left without live edges
+ * was absorbed or has won, so its view is never queried again and is freed
+ * @brief NeighbourDegreeView::update
+ * @param u
+ */
+void NeighbourDegreeView::update(const quint32 &u)
+{
+    QVector<QPair<quint32,quint32> > &w = watcher[u];
+    if (w.isEmpty())
+        return;
+    CSRGraph * topology = myGraph->getTopology();
+    EdgeTable * edges = myGraph->getEdgeTable();
+    quint32 d = topology->getDegree(u);
+    int kept = 0;
+    for (int i = 0; i < w.size(); i++)
+    {
+        quint32 viewer = w[i].first, item = w[i].second;
+        if (topology->getDegree(viewer) == 0)
+        {
+            if (!viewEdge[viewer].isEmpty())
+            {
+                view[viewer] = BucketQueue();
+                viewEdge[viewer].clear();
+            }
+            continue;
+        }
+        BucketQueue &b = view[viewer];
+        if (b.getKey(item) == 0)
+            continue;
+        if (edges->isAlive(viewEdge[viewer].at(item)))
+            b.decrease_to(item, d);
+        else
+            b.decrease_to(item, 0);
+        if (b.getKey(item) > 0)
+            w[kept++] = w[i];
+    }
+    w.resize(kept);
+}
+
+void NeighbourDegreeView::build(const quint32 &v)
+{
+    CSRGraph * topology = myGraph->getTopology();
+    const quint32 * adj = topology->neighbours(v);
+    const quint32 * eid = topology->edges(v);
+    quint32 d = topology->getDegree(v);
+    QVector<quint32> key(d);
+    QVector<quint32> &e = viewEdge[v];
+    e.resize(d);
+    for (quint32 i = 0; i < d; i++)
+    {
+        key[i] = topology->getDegree(adj[i]);
+        e[i] = eid[i];
+        watcher[adj[i]].append(qMakePair(v, i));
+    }
+    view[v].build(key);
+    built.setBit(v);
+}
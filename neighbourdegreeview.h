@@ -0,0 +1,44 @@
+#ifndef NEIGHBOURDEGREEVIEW_H
+#define NEIGHBOURDEGREEVIEW_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QPair>
+#include <QBitArray>
+
+#include "bucketqueue.h"
+
+class Graph;
+class Vertex;
+
+/** Per vertex view of its neighbours bucketed by current degree (II.d - II.g)
+ * The view of a vertex is built the first time it is queried: a BucketQueue
+ * over its live slots keyed by the degree of the neighbour, key 0 marking a
+ * detached edge. Every built view registers itself as a watcher of its
+ * neighbours, so when a merge lowers the degree of u only the views that
+ * actually hold u are moved. Degrees only decrease in these variants, which
+ * is all a BucketQueue supports, and the minimum with a uniform tie-break
+ * is a contiguous bucket. A view only has buckets for the degrees it holds,
+ * so it costs O(d(v)) however large its neighbours are, and watcher entries
+ * are dropped once they cannot change any more.
+ */
+class NeighbourDegreeView
+{
+public:
+    NeighbourDegreeView(Graph * graph);
+
+    quint32 smallest(Vertex * v);
+    void update(const quint32 &u);
+
+private:
+    void build(const quint32 &v);
+
+    Graph * myGraph;
+    QVector<BucketQueue> view;
+    QVector<QVector<quint32> > viewEdge;
+    //(viewer, item) pairs of the views that hold a vertex
+    QVector<QVector<QPair<quint32,quint32> > > watcher;
+    QBitArray built;
+};
+
+#endif // NEIGHBOURDEGREEVIEW_H
@@ -0,0 +1,98 @@
+#include "neighboursampler.h"
+#include "graph.h"
+#include "vertex.h"
+#include "csrgraph.h"
+#include "edgetable.h"
+
+const int NeighbourSampler::MaxRejection;
+
+/** Tables are built lazily, nothing is allocated per vertex up front
+ * @brief NeighbourSampler::NeighbourSampler
+ * @param graph
+ * @param bias StaticWeight: Pr(u) ~ w(u), w must not change during the run;
+ *             CurrentDegree: Pr(u) ~ d(u)
+ */
+NeighbourSampler::NeighbourSampler(Graph *graph, Bias bias)
+{
+    myGraph = graph;
+    myBias = bias;
+    quint32 n = graph->getTopology()->getNumberVertex();
+    table.resize(n);
+    tableEdge.resize(n);
+    tableDegree.resize(n);
+}
+
+/** Draw one live edge of v, biased by the weight of the opposite endpoint
+ * @brief NeighbourSampler::sample
+ * @param v must have at least one live edge
+ * @return the edge index
+ */
+quint32 NeighbourSampler::sample(Vertex *v)
+{
+    quint32 id = v->getIndex();
+    if (v->getNumberEdge() == 0)
+    {
+        qDebug() << "Sampler: Vertex" << id << "Has No Neighbour!";
+        return EdgeTable::NoEdge;
+    }
+    CSRGraph * topology = myGraph->getTopology();
+    EdgeTable * edges = myGraph->getEdgeTable();
+    RandomStream &gen = myGraph->getGenerator();
+    if (table[id].empty())
+        rebuild(id);
+    int rejection = 0;
+    while (true)
+    {
+        if (rejection == MaxRejection)
+        {
+            rebuild(id);
+            rejection = 0;
+        }
+        if (table[id].empty()) //every weight is zero, fall back to uniform
+        {
+            return v->getEdge(gen.bounded(v->getNumberEdge()));
+        }
+        quint32 k = table[id].sample(gen);
+        quint32 e = tableEdge[id][k];
+        rejection++;
+        if (!edges->isAlive(e))
+            continue;
+        if (myBias == CurrentDegree)
+        {
+            quint32 now = topology->getDegree(edges->getOther(e, id));
+            if (gen.uniform01() * tableDegree[id][k] >= now)
+                continue;
+        }
+        return e;
+    }
+}
+
+/** Rebuild the table of v from its live edges
+ * @brief NeighbourSampler::rebuild
+ * @param v
+ */
+void NeighbourSampler::rebuild(const quint32 &v)
+{
+    CSRGraph * topology = myGraph->getTopology();
+    const quint32 * adj = topology->neighbours(v);
+    const quint32 * eid = topology->edges(v);
+    quint32 d = topology->getDegree(v);
+    QVector<quint64> weight(d);
+    QVector<quint32> &edge = tableEdge[v];
+    QVector<quint32> &degree = tableDegree[v];
+    edge.resize(d);
+    if (myBias == CurrentDegree)
+        degree.resize(d);
+    for (quint32 i = 0; i < d; i++)
+    {
+        edge[i] = eid[i];
+        if (myBias == CurrentDegree)
+        {
+            degree[i] = topology->getDegree(adj[i]);
+            weight[i] = degree[i];
+        }
+        else
+            weight[i] = myGraph->getVertex(adj[i])->getWeight();
+    }
+    table[v].build(weight);
+}
@@ -0,0 +1,40 @@
+#ifndef NEIGHBOURSAMPLER_H
+#define NEIGHBOURSAMPLER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+#include "aliastable.h"
+
+class Graph;
+class Vertex;
+
+/** Weighted choice of a neighbour for the biased aggregations (II.a, II.b)
+ * Each vertex gets an alias table over the neighbours it has when it is
+ * first sampled. A draw rejects edges that have been detached since then,
+ * and for CurrentDegree also keeps u only with probability
+ * d_now(u) / d_built(u), which is exact because degrees never grow during a
+ * run. After too many rejections in a row the table of the vertex is rebuilt.
+ */
+class NeighbourSampler
+{
+public:
+    enum Bias { StaticWeight, CurrentDegree };
+
+    NeighbourSampler(Graph * graph, Bias bias);
+
+    quint32 sample(Vertex * v);
+
+private:
+    void rebuild(const quint32 &v);
+
+    static const int MaxRejection = 16;
+
+    Graph * myGraph;
+    Bias myBias;
+    QVector<AliasTable> table;
+    QVector<QVector<quint32> > tableEdge;
+    QVector<QVector<quint32> > tableDegree;
+};
+
+#endif // NEIGHBOURSAMPLER_H
@@ -0,0 +1,78 @@
+#include "neighbourweightheap.h"
+#include "graph.h"
+#include "vertex.h"
+#include "csrgraph.h"
+#include "edgetable.h"
+
+#include <algorithm>
+
+/** Ordering for the std heap functions, the lightest entry ends up on top
+ */
+static bool heavier(const NeighbourWeightHeap::Entry &a, const NeighbourWeightHeap::Entry &b)
+{
+    if (a.weight != b.weight)
+        return a.weight > b.weight;
+    return a.tag > b.tag;
+}
+
+NeighbourWeightHeap::NeighbourWeightHeap(Graph *graph)
+{
+    myGraph = graph;
+    quint32 n = graph->getTopology()->getNumberVertex();
+    heap.resize(n);
+    built.fill(false, n);
+}
+
+/** Live edge of v towards a neighbour of minimum weight
+ * @brief NeighbourWeightHeap::lightest
+ * @param v
+ * @return the edge index, EdgeTable::NoEdge if v has no live edge
+ */
+quint32 NeighbourWeightHeap::lightest(Vertex *v)
+{
+    quint32 id = v->getIndex();
+    if (!built.testBit(id))
+        build(id);
+    EdgeTable * edges = myGraph->getEdgeTable();
+    QVector<Entry> &h = heap[id];
+    while (!h.isEmpty())
+    {
+        std::pop_heap(h.begin(), h.end(), heavier);
+        Entry top = h.last();
+        if (!edges->isAlive(top.edge))
+        {
+            h.removeLast();
+            continue;
+        }
+        quint64 w = myGraph->getVertex(edges->getOther(top.edge, id))->getWeight();
+        if (w != top.weight)
+        {
+            h.last().weight = w;
+            h.last().tag = myGraph->getGenerator()();
+            std::push_heap(h.begin(), h.end(), heavier);
+            continue;
+        }
+        std::push_heap(h.begin(), h.end(), heavier);
+        return top.edge;
+    }
+    qDebug() << "Neighbour Heap: Vertex" << id << "Has No Neighbour!";
+    return EdgeTable::NoEdge;
+}
+
+void NeighbourWeightHeap::build(const quint32 &v)
+{
+    CSRGraph * topology = myGraph->getTopology();
+    const quint32 * adj = topology->neighbours(v);
+    const quint32 * eid = topology->edges(v);
+    quint32 d = topology->getDegree(v);
+    QVector<Entry> &h = heap[v];
+    h.resize(d);
+    for (quint32 i = 0; i < d; i++)
+    {
+        h[i].weight = myGraph->getVertex(adj[i])->getWeight();
+        h[i].tag = myGraph->getGenerator()();
+        h[i].edge = eid[i];
+    }
+    std::make_heap(h.begin(), h.end(), heavier);
+    built.setBit(v);
+}
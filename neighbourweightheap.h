@@ -0,0 +1,41 @@
+#ifndef NEIGHBOURWEIGHTHEAP_H
+#define NEIGHBOURWEIGHTHEAP_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QBitArray>
+
+class Graph;
+class Vertex;
+
+/** Per vertex min-heap over the weights of its neighbours (II.h)
+ * A heap is built the first time its vertex is queried and then kept
+ * lazily: entries of detached edges are dropped when they reach the top,
+ * and an entry whose neighbour has grown heavier since it was pushed is
+ * pushed again with the current weight. Weights only grow during a run,
+ * so an entry that is current when it reaches the top is a true minimum.
+ * Random tags break ties between equal weights uniformly.
+ */
+class NeighbourWeightHeap
+{
+public:
+    NeighbourWeightHeap(Graph * graph);
+
+    quint32 lightest(Vertex * v);
+
+    struct Entry
+    {
+        quint64 weight;
+        quint32 tag;
+        quint32 edge;
+    };
+
+private:
+    void build(const quint32 &v);
+
+    Graph * myGraph;
+    QVector<QVector<Entry> > heap;
+    QBitArray built;
+};
+
+#endif // NEIGHBOURWEIGHTHEAP_H
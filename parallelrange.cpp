@@ -0,0 +1,62 @@
+#include "parallelrange.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/** Hardware threads available, at least 1
+ * @brief ParallelRange::getNumberThread
+ */
+quint32 ParallelRange::getNumberThread()
+{
+    quint32 t = std::thread::hardware_concurrency();
+    return t == 0 ? 1 : t;
+}
+
+/** Threads run() will use for n items in chunks of chunk
+ * Callers size their per-thread scratch with it
+ * @brief ParallelRange::getNumberThread
+ * @param n
+ * @param chunk
+ */
+quint32 ParallelRange::getNumberThread(const quint32 &n, const quint32 &chunk)
+{
+    quint64 noOfChunk = (quint64(n) + chunk - 1) / chunk;
+    return quint32(qMax(quint64(1), qMin(quint64(getNumberThread()), noOfChunk)));
+}
+
+/** Call body(thread, begin, end) over consecutive chunks covering [0, n)
+ * thread is in [0, getNumberThread(n, chunk)), each chunk is seen once
+ * @brief ParallelRange::run
+ * @param n
+ * @param chunk
+ * @param body
+ */
+void ParallelRange::run(const quint32 &n, const quint32 &chunk, const Body &body)
+{
+    quint32 noOfThread = getNumberThread(n, chunk);
+    if (noOfThread == 1)
+    {
+        if (n > 0)
+            body(0, 0, n);
+        return;
+    }
+    std::atomic<quint64> next(0);
+    auto worker = [&](quint32 thread)
+    {
+        for (;;)
+        {
+            quint64 begin = next.fetch_add(chunk);
+            if (begin >= n)
+                break;
+            quint64 end = qMin(quint64(n), begin + chunk);
+            body(thread, quint32(begin), quint32(end));
+        }
+    };
+    std::vector<std::thread> pool;
+    for (quint32 t = 1; t < noOfThread; t++)
+        pool.push_back(std::thread(worker, t));
+    worker(0);
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+}
@@ -0,0 +1,22 @@
+#ifndef PARALLELRANGE_H
+#define PARALLELRANGE_H
+
+#include <QtGlobal>
+#include <functional>
+
+/** Split [0, n) into chunks handed out to worker threads on demand
+ * Threads pull the next chunk from a shared counter, so a few expensive
+ * chunks (the hubs of a power-law graph) do not hold up a static partition.
+ * Small ranges run on the calling thread without spawning anything.
+ */
+class ParallelRange
+{
+public:
+    typedef std::function<void(quint32 thread, quint32 begin, quint32 end)> Body;
+
+    static quint32 getNumberThread();
+    static quint32 getNumberThread(const quint32 &n, const quint32 &chunk);
+    static void run(const quint32 &n, const quint32 &chunk, const Body &body);
+};
+
+#endif // PARALLELRANGE_H
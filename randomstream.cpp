@@ -0,0 +1,179 @@
+#include "randomstream.h"
+
+static const quint64 GoldenGamma = Q_UINT64_C(0x9e3779b97f4a7c15);
+
+RandomStream::RandomStream()
+{
+    setKey(0);
+}
+
+RandomStream::RandomStream(const quint64 &seed, const quint64 &run, const quint64 &thread)
+{
+    setKey(seed, run, thread);
+}
+
+/** Select the stream of (seed, run, thread) and rewind it to its first draw
+ * @brief RandomStream::setKey
+ * @param seed
+ * @param run
+ * @param thread
+ */
+void RandomStream::setKey(const quint64 &seed, const quint64 &run, const quint64 &thread)
+{
+    quint64 h = mix(seed + GoldenGamma);
+    h = mix(h ^ (run + 2 * GoldenGamma));
+    h = mix(h ^ (thread + 3 * GoldenGamma));
+    key = h;
+    gamma = mix_gamma(h + GoldenGamma);
+    counter = 0;
+    next = BufferSize;
+    hasSpare = false;
+}
+
+/** Skip n draws
+ * @brief RandomStream::discard
+ * @param n
+ */
+void RandomStream::discard(const quint64 &n)
+{
+    counter = getCounter() + n;
+    next = BufferSize;
+    hasSpare = false;
+}
+
+/** Number of words drawn from the stream so far
+ * @brief RandomStream::getCounter
+ */
+quint64 RandomStream::getCounter() const
+{
+    return counter - BufferSize + next;
+}
+
+RandomStream::result_type RandomStream::operator()()
+{
+    if (next == BufferSize)
+        refill();
+    return buffer[next++];
+}
+
+/** Uniform integer in [0, range), range must not be 0
+ * Lemire's nearly divisionless method on 32 bit halves of the words
+ * @brief RandomStream::bounded
+ * @param range
+ * @return
+ */
+quint32 RandomStream::bounded(const quint32 &range)
+{
+    quint64 m = quint64(next32()) * range;
+    quint32 low = quint32(m);
+    if (low < range)
+    {
+        quint32 threshold = (0u - range) % range;
+        while (low < threshold)
+        {
+            m = quint64(next32()) * range;
+            low = quint32(m);
+        }
+    }
+    return quint32(m >> 32);
+}
+
+/** Uniform integer in [0, range) for 64 bit ranges, range must not be 0
+ * The same method on whole words, with a 64 x 64 -> 128 bit product
+ * @brief RandomStream::bounded64
+ * @param range
+ * @return
+ */
+quint64 RandomStream::bounded64(const quint64 &range)
+{
+    quint64 low;
+    quint64 high = multiply((*this)(), range, low);
+    if (low < range)
+    {
+        quint64 threshold = (0 - range) % range;
+        while (low < threshold)
+            high = multiply((*this)(), range, low);
+    }
+    return high;
+}
+
+/** Uniform double in [0, 1) from the 53 high bits of one word
+ * @brief RandomStream::uniform01
+ */
+double RandomStream::uniform01()
+{
+    return double((*this)() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/** Generate the next BufferSize words in one pass
+ * Each word only depends on its own counter value, so the loop carries no
+ * dependency and the compiler is free to vectorise it
+ * @brief RandomStream::refill
+ */
+void RandomStream::refill()
+{
+    const quint64 base = key + counter * gamma;
+    for (quint32 i = 0; i < BufferSize; i++)
+        buffer[i] = mix(base + (i + 1) * gamma);
+    counter += BufferSize;
+    next = 0;
+}
+
+quint32 RandomStream::next32()
+{
+    if (hasSpare)
+    {
+        hasSpare = false;
+        return spare;
+    }
+    quint64 w = (*this)();
+    spare = quint32(w >> 32);
+    hasSpare = true;
+    return quint32(w);
+}
+
+/** Full product of a and b
+ * @brief RandomStream::multiply
+ * @param low receives the lower 64 bits
+ * @return the upper 64 bits
+ */
+quint64 RandomStream::multiply(const quint64 &a, const quint64 &b, quint64 &low)
+{
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 m = (unsigned __int128) a * b;
+    low = quint64(m);
+    return quint64(m >> 64);
+#else
+    quint64 aLow = quint32(a), aHigh = a >> 32, bLow = quint32(b), bHigh = b >> 32;
+    quint64 ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+    quint64 middle = (ll >> 32) + quint32(lh) + quint32(hl);
+    low = (middle << 32) | quint32(ll);
+    return hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+#endif
+}
+
+/** SplitMix64 finaliser
+ * @brief RandomStream::mix
+ */
+quint64 RandomStream::mix(quint64 z)
+{
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+/** Odd increment of the Weyl sequence, with enough bit transitions to
+ * avoid the weak gammas of SplittableRandom
+ * @brief RandomStream::mix_gamma
+ */
+quint64 RandomStream::mix_gamma(quint64 z)
+{
+    z = mix(z) | 1;
+    quint64 flips = z ^ (z >> 1);
+    int n = 0;
+    for (; flips; flips &= flips - 1)
+        n++;
+    if (n < 24)
+        z ^= Q_UINT64_C(0xaaaaaaaaaaaaaaaa);
+    return z;
+}
@@ -0,0 +1,61 @@
+#ifndef RANDOMSTREAM_H
+#define RANDOMSTREAM_H
+
+#include <QtGlobal>
+#include <random>
+
+/** Counter based generator keyed by (seed, run, thread)
+ * Draw n of a stream is mix(key + n * gamma), the SplitMix64 finaliser
+ * applied to a Weyl sequence, so the state is just a counter: there is no
+ * engine to warm up, discard() is O(1) and two streams with different keys
+ * are independent. Key and gamma are both hashed from the triple, a run is
+ * therefore bit for bit reproducible from its seed, its run number and the
+ * thread it ran on, whatever the other runs or threads drew before.
+ * Satisfies UniformRandomBitGenerator, so it plugs into std distributions.
+ * Words are produced BufferSize at a time by a branch free loop over the
+ * counter, and bounded() maps them to [0, range) with Lemire's multiply and
+ * shift, which only divides in the rare case the draw has to be rejected.
+ * bounded64() does the same on whole words for 64 bit ranges and uniform01()
+ * turns one word into a double, so hot loops need no std distribution.
+ * Buffering does not change the sequence, draw n is the same either way.
+ */
+class RandomStream
+{
+public:
+    typedef quint64 result_type;
+
+    RandomStream();
+    RandomStream(const quint64 &seed, const quint64 &run = 0, const quint64 &thread = 0);
+
+    void setKey(const quint64 &seed, const quint64 &run = 0, const quint64 &thread = 0);
+    void discard(const quint64 &n);
+    quint64 getCounter() const;
+
+    result_type operator()();
+    quint32 bounded(const quint32 &range);
+    quint64 bounded64(const quint64 &range);
+    double uniform01();
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    enum { BufferSize = 256 };
+
+private:
+    static quint64 mix(quint64 z);
+    static quint64 mix_gamma(quint64 z);
+    void refill();
+    quint32 next32();
+    static quint64 multiply(const quint64 &a, const quint64 &b, quint64 &low);
+
+    quint64 key;
+    quint64 gamma;
+    //draws generated so far, next is the first unread slot of buffer
+    quint64 counter;
+    quint32 next;
+    quint64 buffer[BufferSize];
+    //the upper half of a word already split by next32
+    quint32 spare;
+    bool hasSpare;
+};
+
+#endif // RANDOMSTREAM_H
@@ -0,0 +1,157 @@
+#include "sortedintersection.h"
+
+#ifdef RANAGG_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/** Intersection size through the fastest kernel for these sizes
+ * @brief SortedIntersection::count
+ * @param a
+ * @param na
+ * @param b
+ * @param nb
+ * @return
+ */
+quint32 SortedIntersection::count(const quint32 *a, const quint32 &na, const quint32 *b, const quint32 &nb)
+{
+    static const Kernel kernel = select_kernel();
+    if (na == 0 || nb == 0)
+        return 0;
+    if (na > nb)
+        return count(b, nb, a, na);
+    if (nb / na >= GallopRatio)
+        return count_galloping(a, na, b, nb);
+    return kernel(a, na, b, nb);
+}
+
+/** Plain merge, the reference for the other kernels
+ * @brief SortedIntersection::count_scalar
+ */
+quint32 SortedIntersection::count_scalar(const quint32 *a, const quint32 &na, const quint32 *b, const quint32 &nb)
+{
+    quint32 i = 0, j = 0, c = 0;
+    while (i < na && j < nb)
+    {
+        if (a[i] < b[j])
+            i++;
+        else if (a[i] > b[j])
+            j++;
+        else
+        {
+            c++;
+            i++;
+            j++;
+        }
+    }
+    return c;
+}
+
+/** Exponential then binary search of every element of the short list a
+ * in what is left of the long list b
+ * @brief SortedIntersection::count_galloping
+ */
+quint32 SortedIntersection::count_galloping(const quint32 *a, const quint32 &na, const quint32 *b, const quint32 &nb)
+{
+    quint32 j = 0, c = 0;
+    for (quint32 i = 0; i < na && j < nb; i++)
+    {
+        quint32 x = a[i];
+        if (b[j] < x)
+        {
+            //find a window (lo, hi] with b[lo] < x <= b[hi]
+            quint32 lo = j, step = 1;
+            quint32 hi = j + 1;
+            while (hi < nb && b[hi] < x)
+            {
+                lo = hi;
+                step <<= 1;
+                hi = lo + step;
+            }
+            if (hi > nb)
+                hi = nb;
+            while (lo + 1 < hi)
+            {
+                quint32 mid = lo + (hi - lo) / 2;
+                if (b[mid] < x)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            j = hi;
+        }
+        if (j < nb && b[j] == x)
+        {
+            c++;
+            j++;
+        }
+    }
+    return c;
+}
+
+#ifdef RANAGG_X86_SIMD
+
+__attribute__((target("sse4.1")))
+quint32 SortedIntersection::count_sse41(const quint32 *a, const quint32 &na, const quint32 *b, const quint32 &nb)
+{
+    quint32 i = 0, j = 0, c = 0;
+    const quint32 endA = na & ~3u, endB = nb & ~3u;
+    while (i < endA && j < endB)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        c += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        quint32 lastA = a[i + 3], lastB = b[j + 3];
+        if (lastA <= lastB)
+            i += 4;
+        if (lastB <= lastA)
+            j += 4;
+    }
+    return c + count_scalar(a + i, na - i, b + j, nb - j);
+}
+
+__attribute__((target("avx2")))
+quint32 SortedIntersection::count_avx2(const quint32 *a, const quint32 &na, const quint32 *b, const quint32 &nb)
+{
+    quint32 i = 0, j = 0, c = 0;
+    const quint32 endA = na & ~7u, endB = nb & ~7u;
+    const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    while (i < endA && j < endB)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; r++)
+        {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+        }
+        c += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        quint32 lastA = a[i + 7], lastB = b[j + 7];
+        if (lastA <= lastB)
+            i += 8;
+        if (lastB <= lastA)
+            j += 8;
+    }
+    return c + count_scalar(a + i, na - i, b + j, nb - j);
+}
+
+#endif
+
+/** Widest merge kernel the CPU supports
+ * @brief SortedIntersection::select_kernel
+ */
+SortedIntersection::Kernel SortedIntersection::select_kernel()
+{
+#ifdef RANAGG_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &SortedIntersection::count_avx2;
+    if (__builtin_cpu_supports("sse4.1"))
+        return &SortedIntersection::count_sse41;
+#endif
+    return &SortedIntersection::count_scalar;
+}
@@ -0,0 +1,39 @@
+#ifndef SORTEDINTERSECTION_H
+#define SORTEDINTERSECTION_H
+
+#include <QtGlobal>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RANAGG_X86_SIMD
+#endif
+
+/** Size of the intersection of two strictly increasing lists of indices
+ * Used to count common neighbours on the sorted CSR slices.
+ * count() gallops through the longer list when the sizes are far apart and
+ * otherwise runs a block merge: every block of one list is compared with all
+ * rotations of the current block of the other and the block with the smaller
+ * last element moves on. The AVX2 (8 wide) or SSE4.1 (4 wide) version is
+ * picked once from the CPU features, the scalar merge is the reference and
+ * the only path on other compilers and architectures.
+ */
+class SortedIntersection
+{
+public:
+    static quint32 count(const quint32 * a, const quint32 &na, const quint32 * b, const quint32 &nb);
+
+    static quint32 count_scalar(const quint32 * a, const quint32 &na, const quint32 * b, const quint32 &nb);
+    static quint32 count_galloping(const quint32 * a, const quint32 &na, const quint32 * b, const quint32 &nb);
+#ifdef RANAGG_X86_SIMD
+    static quint32 count_sse41(const quint32 * a, const quint32 &na, const quint32 * b, const quint32 &nb);
+    static quint32 count_avx2(const quint32 * a, const quint32 &na, const quint32 * b, const quint32 &nb);
+#endif
+
+    //galloping pays off once the longer list is this many times the shorter
+    enum { GallopRatio = 32 };
+
+private:
+    typedef quint32 (*Kernel)(const quint32 *, const quint32 &, const quint32 *, const quint32 &);
+    static Kernel select_kernel();
+};
+
+#endif // SORTEDINTERSECTION_H
@@ -0,0 +1,199 @@
+#include "trianglesupport.h"
+#include "csrgraph.h"
+#include "parallelrange.h"
+
+#include <atomic>
+#include <vector>
+
+TriangleSupport::TriangleSupport()
+{
+    tag = 0;
+    built = false;
+    tracking = false;
+}
+
+/** Count the triangles of every edge and vertex with the forward algorithm
+ * Every edge is oriented towards the endpoint of higher (degree, index),
+ * which leaves O(sqrt(E)) out-neighbours per vertex. A triangle is then
+ * found exactly once, from its lowest vertex u and middle vertex v, as a
+ * common out-neighbour w of both. Ranges of u run on all cores, the three
+ * edge counters of a triangle are bumped atomically.
+ * @brief TriangleSupport::build
+ * @param g
+ */
+void TriangleSupport::build(const CSRGraph &g)
+{
+    quint32 n = g.getNumberVertex();
+    quint32 m = g.getNumberEdge();
+
+    QVector<quint32> outOffset(n + 1, 0);
+    for (quint32 u = 0; u < n; u++)
+    {
+        const quint32 * adj = g.initialNeighbours(u);
+        quint32 d = g.getInitialDegree(u);
+        for (quint32 i = 0; i < d; i++)
+            if (precedes(g, u, adj[i]))
+                outOffset[u + 1]++;
+    }
+    for (quint32 u = 0; u < n; u++)
+        outOffset[u + 1] += outOffset[u];
+    //the base slices are sorted, so are the out lists
+    QVector<quint32> outNeighbour(outOffset[n]), outEdge(outOffset[n]);
+    for (quint32 u = 0; u < n; u++)
+    {
+        const quint32 * adj = g.initialNeighbours(u);
+        const quint32 * eid = g.initialEdges(u);
+        quint32 d = g.getInitialDegree(u);
+        quint32 s = outOffset[u];
+        for (quint32 i = 0; i < d; i++)
+        {
+            if (precedes(g, u, adj[i]))
+            {
+                outNeighbour[s] = adj[i];
+                outEdge[s] = eid[i];
+                s++;
+            }
+        }
+    }
+
+    std::vector<std::atomic<quint32> > count(m);
+    ParallelRange::run(n, ChunkSize, [&](quint32, quint32 begin, quint32 end)
+    {
+        for (quint32 u = begin; u < end; u++)
+        {
+            for (quint32 i = outOffset[u]; i < outOffset[u + 1]; i++)
+            {
+                quint32 v = outNeighbour[i];
+                quint32 p = outOffset[u], q = outOffset[v];
+                while (p < outOffset[u + 1] && q < outOffset[v + 1])
+                {
+                    if (outNeighbour[p] < outNeighbour[q])
+                        p++;
+                    else if (outNeighbour[p] > outNeighbour[q])
+                        q++;
+                    else
+                    {
+                        count[outEdge[i]].fetch_add(1, std::memory_order_relaxed);
+                        count[outEdge[p]].fetch_add(1, std::memory_order_relaxed);
+                        count[outEdge[q]].fetch_add(1, std::memory_order_relaxed);
+                        p++;
+                        q++;
+                    }
+                }
+            }
+        }
+    });
+
+    base.resize(m);
+    for (quint32 e = 0; e < m; e++)
+        base[e] = count[e].load(std::memory_order_relaxed);
+    //every triangle of v lies on two of its edges
+    vertexTriangle.resize(n);
+    for (quint32 v = 0; v < n; v++)
+    {
+        const quint32 * eid = g.initialEdges(v);
+        quint32 d = g.getInitialDegree(v);
+        quint64 sum = 0;
+        for (quint32 i = 0; i < d; i++)
+            sum += base[eid[i]];
+        vertexTriangle[v] = sum / 2;
+    }
+    mark.fill(0, n);
+    tag = 0;
+    built = true;
+    tracking = false;
+}
+
+void TriangleSupport::clear()
+{
+    base.clear();
+    vertexTriangle.clear();
+    live.clear();
+    mark.clear();
+    tag = 0;
+    built = false;
+    tracking = false;
+}
+
+bool TriangleSupport::isBuilt() const
+{
+    return built;
+}
+
+/** Start keeping the counts current from the loaded graph
+ * Must be called before the run removes anything
+ * @brief TriangleSupport::track
+ */
+void TriangleSupport::track()
+{
+    live = base;
+    tracking = true;
+}
+
+void TriangleSupport::stop()
+{
+    tracking = false;
+}
+
+bool TriangleSupport::isTracking() const
+{
+    return tracking;
+}
+
+quint32 TriangleSupport::get(const quint32 &e) const
+{
+    return live[e];
+}
+
+/** Triangles through v in the loaded graph
+ * @brief TriangleSupport::getVertexTriangles
+ * @param v
+ */
+quint64 TriangleSupport::getVertexTriangles(const quint32 &v) const
+{
+    return vertexTriangle[v];
+}
+
+/** u comes before v in the degree ordering, self loops are never oriented
+ * @brief TriangleSupport::precedes
+ */
+bool TriangleSupport::precedes(const CSRGraph &g, const quint32 &u, const quint32 &v)
+{
+    quint32 du = g.getInitialDegree(u), dv = g.getInitialDegree(v);
+    return du < dv || (du == dv && u < v);
+}
+
+/** v is about to lose all of its edges: every live triangle (v, a, b)
+ * breaks and edge (a, b) loses one unit of support
+ * @brief TriangleSupport::remove_vertex
+ * @param g the topology before v is detached
+ * @param v
+ */
+void TriangleSupport::remove_vertex(const CSRGraph &g, const quint32 &v)
+{
+    tag++;
+    if (tag == 0)
+    {
+        mark.fill(0);
+        tag = 1;
+    }
+    const quint32 * adj = g.neighbours(v);
+    quint32 d = g.getDegree(v);
+    for (quint32 i = 0; i < d; i++)
+        mark[adj[i]] = tag;
+    for (quint32 i = 0; i < d; i++)
+    {
+        quint32 a = adj[i];
+        if (a == v)
+            continue;
+        const quint32 * adjA = g.neighbours(a);
+        const quint32 * eidA = g.edges(a);
+        quint32 dA = g.getDegree(a);
+        for (quint32 j = 0; j < dA; j++)
+        {
+            quint32 b = adjA[j];
+            if (a < b && b != v && mark[b] == tag)
+                live[eidA[j]]--;
+        }
+    }
+}
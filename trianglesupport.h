@@ -0,0 +1,48 @@
+#ifndef TRIANGLESUPPORT_H
+#define TRIANGLESUPPORT_H
+
+#include <QtGlobal>
+#include <QVector>
+
+class CSRGraph;
+
+/** Number of triangles each edge belongs to (III.a - III.e)
+ * The counts of the loaded graph are computed in parallel when it is loaded
+ * (with the triangles of every vertex alongside), a run that wants them
+ * starts tracking from a copy and only the triangles broken by removing a
+ * vertex are decremented afterwards, so a query is a single array read.
+ * Runs that never ask for triangles pay nothing for the removals.
+ */
+class TriangleSupport
+{
+public:
+    TriangleSupport();
+
+    void build(const CSRGraph &g);
+    void clear();
+    bool isBuilt() const;
+
+    void track();
+    void stop();
+    bool isTracking() const;
+
+    quint32 get(const quint32 &e) const;
+    quint64 getVertexTriangles(const quint32 &v) const;
+    void remove_vertex(const CSRGraph &g, const quint32 &v);
+
+    enum { ChunkSize = 1024 };
+
+private:
+    static bool precedes(const CSRGraph &g, const quint32 &u, const quint32 &v);
+
+    QVector<quint32> base;
+    QVector<quint64> vertexTriangle;
+    QVector<quint32> live;
+    //mark[x] == tag when x is a neighbour of the vertex being processed
+    QVector<quint32> mark;
+    quint32 tag;
+    bool built;
+    bool tracking;
+};
+
+#endif // TRIANGLESUPPORT_H
@@ -0,0 +1,60 @@
+#include "unionfind.h"
+
+UnionFind::UnionFind()
+{
+}
+
+/** Every index in [0, n) becomes a singleton
+ * @brief UnionFind::reset
+ * @param n
+ */
+void UnionFind::reset(const quint32 &n)
+{
+    parent.resize(n);
+    for (quint32 i = 0; i < n; i++)
+        parent[i] = i;
+    setSize.fill(1, n);
+}
+
+/** Representative of the set containing v, compresses the path on the way
+ * @brief UnionFind::find
+ * @param v
+ * @return
+ */
+quint32 UnionFind::find(const quint32 &v)
+{
+    quint32 root = v;
+    while (parent[root] != root)
+        root = parent[root];
+    quint32 cur = v;
+    while (parent[cur] != root)
+    {
+        quint32 next = parent[cur];
+        parent[cur] = root;
+        cur = next;
+    }
+    return root;
+}
+
+/** Merge the sets of a and b, the smaller one hangs below the larger
+ * @brief UnionFind::unite
+ * @param a
+ * @param b
+ * @return the representative of the merged set
+ */
+quint32 UnionFind::unite(const quint32 &a, const quint32 &b)
+{
+    quint32 ra = find(a), rb = find(b);
+    if (ra == rb)
+        return ra;
+    if (setSize[ra] < setSize[rb])
+        qSwap(ra, rb);
+    parent[rb] = ra;
+    setSize[ra] += setSize[rb];
+    return ra;
+}
+
+quint32 UnionFind::getSize(const quint32 &v)
+{
+    return setSize[find(v)];
+}
@@ -0,0 +1,26 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+#include <QtGlobal>
+#include <QVector>
+
+/** Disjoint sets over the vertex indices, one set per cluster
+ * Union by size and path compression, so merging two clusters is
+ * almost constant time regardless of how many members they hold.
+ */
+class UnionFind
+{
+public:
+    UnionFind();
+
+    void reset(const quint32 &n);
+    quint32 find(const quint32 &v);
+    quint32 unite(const quint32 &a, const quint32 &b);
+    quint32 getSize(const quint32 &v);
+
+private:
+    QVector<quint32> parent;
+    QVector<quint32> setSize;
+};
+
+#endif // UNIONFIND_H
@@ -1,15 +1,19 @@
 #include "vertex.h"
-#include "edge.h"
+#include "graph.h"
+#include "csrgraph.h"
+#include "edgetable.h"
+#include "unionfind.h"
+#include "trianglesupport.h"
 
 #include <QTime>
 #include <QDebug>
 #include <QTime>
 
-std::default_random_engine gen;
+#include <algorithm>
 
-
-Vertex::Vertex()
+Vertex::Vertex(Graph *graph)
 {
+    myGraph = graph;
     myWeight = 1;
     parent = 0;
     isDraggedAlong = false;
@@ -17,14 +21,10 @@ Vertex::Vertex()
     noOfChild = 0;
     ExtraWeight = 0;
     myRealCommunity = -1;
-    gen.seed(QTime::currentTime().msec());
-
 }
 
 Vertex::~Vertex()
 {
-    foreach (Edge *edge, myEdge)
-        delete edge;
 }
 
 void Vertex::setIndex(const quint32 &number)
@@ -37,41 +37,30 @@ quint32 Vertex::getIndex() const
     return myIndex;
 }
 
-
-void Vertex::addAdj(const quint32 &index)
-{
-    if (!myNeighbours.contains(index))
-        myNeighbours.append(index);
-    else
-        qDebug() << "NEIGHBOUR ALREADY EXISTS, SKIPPING";
-}
-
-quint32 Vertex::getNumAdj() const
+/** The adjacency of every vertex lives in the graph's CSR arrays
+ * @brief Vertex::topology
+ */
+CSRGraph *Vertex::topology() const
 {
-    return myNeighbours.size();
+    return myGraph->getTopology();
 }
 
-quint32 Vertex::getOneNeighbourIndex(const quint32 &index)
+EdgeTable *Vertex::edgeTable() const
 {
-    if (myNeighbours.size()+1 > index)
-        return myNeighbours.at(index);
-    else
-        qDebug() << "Out of Bound While Getting A Neighbour";
+    return myGraph->getEdgeTable();
 }
 
-
-void Vertex::removeAdj(const quint32 &index)
+quint32 Vertex::getNumAdj() const
 {
-    if (myNeighbours.contains(index))
-        myNeighbours.removeAll(index);
-    else
-    {}
+    return topology()->getDegree(myIndex);
 }
 
-void Vertex::removeAll()
+quint32 Vertex::getOneNeighbourIndex(const quint32 &index)
 {
-    foreach (Edge *edge, myEdge)
-       edge->removeAll();
+    if (index < getNumAdj())
+        return topology()->getNeighbour(myIndex, index);
+    qDebug() << "Out of Bound While Getting A Neighbour";
+    return myIndex;
 }
 
 void Vertex::setWeight(const quint64 &w)
@@ -81,10 +70,11 @@ void Vertex::setWeight(const quint64 &w)
 
 void Vertex::setWeightAsNumberOfAbsorbed()
 {
-    if (absorbed.size() == 0)
+    quint32 absorbed = myGraph->getClusters()->getSize(myIndex) - 1;
+    if (absorbed == 0)
         return;
     else
-        myWeight = absorbed.size();
+        myWeight = absorbed;
 }
 
 quint64 Vertex::getWeight() const
@@ -106,11 +96,6 @@ void Vertex::setParent(Vertex *v)
             return;
         v->incrementNoChild();
         v->setExtraWeight(this->getWeight());
-
-        //readjustcluter
-        v->addMemberToCluster(this);
-        v->addMemberToCluster(myCluster);
-        myCluster.clear();
     }
 }
 
@@ -158,72 +143,59 @@ Vertex *Vertex::getParent() const
     return parent;
 }
 
-QList<Vertex *> Vertex::getAbsorbedList()
-{
-    return absorbed;
-}
-
 QList<quint32> Vertex::getNeighbourIndexes()
 {
     QList<quint32> indexes;
-    for (int i = 0; i < myEdge.size(); i++)
-    {
-        Vertex * neighbour = this->get_neighbour_fromEdge(myEdge[i]);
-        indexes.append(neighbour->getIndex());
-    }
+    const quint32 * adj = topology()->neighbours(myIndex);
+    quint32 d = getNumberEdge();
+    indexes.reserve(d);
+    for (quint32 i = 0; i < d; i++)
+        indexes.append(adj[i]);
     return indexes;
 }
 
-void Vertex::addEdge(Edge *edge)
-{
-    if (myEdge.contains(edge))
-    {
-        //DUP
-    }
-    else
-        myEdge.append(edge);
-}
-
-void Vertex::removeEdge(Edge *edge)
-{
-    myEdge.removeOne(edge);
-    Vertex * neighbour = this->get_neighbour_fromEdge(edge);
-    myNeighbours.removeOne(neighbour->getIndex());
-}
-
 quint32 Vertex::getNumberEdge() const
 {
-    return myEdge.size();
+    return topology()->getDegree(myIndex);
 }
 
 void Vertex::remove_all_edges()
 {
-    foreach (Edge *edge, myEdge)
-        delete edge;
+    TriangleSupport * triangles = myGraph->getTriangles();
+    if (triangles->isTracking())
+        triangles->remove_vertex(*topology(), myIndex);
+    EdgeTable * table = edgeTable();
+    const quint32 * eid = topology()->edges(myIndex);
+    quint32 d = getNumberEdge();
+    for (quint32 i = 0; i < d; i++)
+        table->kill(eid[i]);
+    topology()->detach_all(myIndex);
 }
 
-Edge *Vertex::getEdgeFromVertex(Vertex * v2)
+quint32 Vertex::getEdgeFromVertex(Vertex * v2)
 {
-    for (int i = 0; i < myEdge.size(); i++)
+    const quint32 * adj = topology()->neighbours(myIndex);
+    quint32 d = getNumberEdge(), index = v2->getIndex();
+    for (quint32 i = 0; i < d; i++)
     {
-        Edge * e = myEdge.at(i);
-        if (e->fromVertex() == v2 || e->toVertex() == v2)
-            return e;
+        if (adj[i] == index)
+            return getEdge(i);
     }
 
     qDebug() << "WARNING ! CANNOT FIND NEIGHBOUR FROM AN EDGE! TERMINATING";
-    return 0;
+    return EdgeTable::NoEdge;
 }
 
-Edge *Vertex::getSmallestCurrentDegreeNeighbour()
+quint32 Vertex::getSmallestCurrentDegreeNeighbour()
 {
     QList<quint32> indexes;
     quint32 smallest = 999999;
-    for (int i = 0; i < myEdge.size(); i++)
+    const CSRGraph * g = topology();
+    const quint32 * adj = g->neighbours(myIndex);
+    quint32 d = getNumberEdge();
+    for (quint32 i = 0; i < d; i++)
     {
-        Edge * e = myEdge.at(i);
-        Vertex * neighbour = this->get_neighbour_fromEdge(e);
-        quint32 w = neighbour->getNumberEdge();
+        quint32 w = g->getDegree(adj[i]);
         if (w < smallest)
         {
             indexes.clear();
@@ -237,24 +209,23 @@ Edge *Vertex::getSmallestCurrentDegreeNeighbour()
     }
 
     if (indexes.size() == 1)
-        return myEdge[indexes[0]];
+        return getEdge(indexes[0]);
     else
     {
-        std::uniform_int_distribution<int> distribution(0,indexes.size()-1);
-        int ran = distribution(gen);
-        return myEdge.at(indexes[ran]);
+        quint32 ran = myGraph->getGenerator().bounded(indexes.size());
+        return getEdge(indexes.at(ran));
     }
 }
 
-Edge *Vertex::getSmallestCurrentWeightNeighbour()
+quint32 Vertex::getSmallestCurrentWeightNeighbour()
 {
     QList<quint32> indexes;
     quint64 smallest = 99999999;
-    for (int i = 0; i < myEdge.size(); i++)
+    const quint32 * adj = topology()->neighbours(myIndex);
+    quint32 d = getNumberEdge();
+    for (quint32 i = 0; i < d; i++)
     {
-        Edge * e = myEdge.at(i);
-        Vertex * neighbour = this->get_neighbour_fromEdge(e);
-        quint64 w = neighbour->getWeight();
+        quint64 w = myGraph->getVertex(adj[i])->getWeight();
         if (w < smallest)
         {
             indexes.clear();
@@ -268,241 +239,135 @@ Edge *Vertex::getSmallestCurrentWeightNeighbour()
     }
 
     if (indexes.size() == 1)
-        return myEdge[indexes[0]];
+        return getEdge(indexes[0]);
     else
     {
-        std::uniform_int_distribution<int> distribution(0,indexes.size()-1);
-        int ran = distribution(gen);
-        return myEdge.at(indexes[ran]);
+        quint32 ran = myGraph->getGenerator().bounded(indexes.size());
+        return getEdge(indexes.at(ran));
     }
 }
 
 
-void Vertex::absorb_removeEdge(quint32 edge_index)
+void Vertex::absorb_removeEdge(quint32 e)
 {
-    Vertex * neighbour = 0;
-    Edge * edge = myEdge.at(edge_index);
-    if (edge->fromVertex() == this)
-        neighbour = edge->toVertex();
-    else
-        neighbour = edge->fromVertex();
-    neighbour->remove_all_edges();
-    absorbed.append(neighbour);
-    absorbed.append(neighbour->getAbsorbedList());
-    neighbour->setParent(this);
-}
-
-void Vertex::absorb_removeEdge(Edge *e)
-{
-    if (!myEdge.contains(e))
+    if (!edgeTable()->hasEndpoint(e, myIndex))
     {
         qDebug() << "Absorb Edge NOT FOUND!";
         return;
     }
-    Vertex * neighbour = 0;
-    if (e->fromVertex() == this)
-        neighbour = e->toVertex();
-    else
-        neighbour = e->fromVertex();
+    Vertex * neighbour = myGraph->getVertex(edgeTable()->getOther(e, myIndex));
    // neighbour->loser_drag_vertex_with_degree_one(e);
     neighbour->remove_all_edges();
-    absorbed.append(neighbour);
-    absorbed.append(neighbour->getAbsorbedList());
+    myGraph->getClusters()->unite(myIndex, neighbour->getIndex());
     neighbour->setParent(this);
 }
 
-void Vertex::absorb_removeVertex_retainEdge(Edge *e)
+void Vertex::absorb_removeVertex_retainEdge(quint32 e)
 {
-    if (!myEdge.contains(e))
+    if (!edgeTable()->hasEndpoint(e, myIndex))
     {
         qDebug() << "Absorb Edge NOT FOUND!";
         return;
     }
-    Vertex * neighbour = 0;
-    if (e->fromVertex() == this)
-        neighbour = e->toVertex();
-    else
-        neighbour = e->fromVertex();
-    absorbed.append(neighbour);
-    absorbed.append(neighbour->getAbsorbedList());
+    Vertex * neighbour = myGraph->getVertex(edgeTable()->getOther(e, myIndex));
+    myGraph->getClusters()->unite(myIndex, neighbour->getIndex());
     neighbour->setParent(this);
 }
 
-void Vertex::absorb_retainEdge(Edge *e)
+void Vertex::absorb_retainEdge(quint32 e)
 {
-    if (!myEdge.contains(e))
+    if (!edgeTable()->hasEndpoint(e, myIndex))
     {
         qDebug() << "Absorb Edge NOT FOUND!";
         return;
     }
-    Vertex * neighbour = 0;
-    if (e->fromVertex() == this)
-        neighbour = e->toVertex();
-    else
-        neighbour = e->fromVertex();
+    Vertex * neighbour = myGraph->getVertex(edgeTable()->getOther(e, myIndex));
 
-    absorbed.append(neighbour);
-    absorbed.append(neighbour->getAbsorbedList());
+    myGraph->getClusters()->unite(myIndex, neighbour->getIndex());
     neighbour->setParent(this);
 }
 
-void Vertex::absorb_retainEdge_setParentPointer(Edge *e)
+void Vertex::absorb_retainEdge_setParentPointer(quint32 e)
 {
-    if (!myEdge.contains(e))
+    if (!edgeTable()->hasEndpoint(e, myIndex))
     {
         qDebug() << "Absorb Edge NOT FOUND!";
         return;
     }
-    Vertex * neighbour = 0;
-    if (e->fromVertex() == this)
-        neighbour = e->toVertex();
-    else
-        neighbour = e->fromVertex();
+    Vertex * neighbour = myGraph->getVertex(edgeTable()->getOther(e, myIndex));
 
-    absorbed.append(neighbour);
-    absorbed.append(neighbour->getAbsorbedList());
+    myGraph->getClusters()->unite(myIndex, neighbour->getIndex());
     neighbour->setParentPointerOnly(this);
 }
 
 void Vertex::absorb_singleton(Vertex *v)
 {
-    absorbed.append(v->getAbsorbedList());
-    absorbed.append(v);
+    myGraph->getClusters()->unite(myIndex, v->getIndex());
     v->setParent(this);
     v->remove_all_edges();
 }
 
-Vertex *Vertex::get_neighbour_fromEdge(quint32 edge_index)
+Vertex *Vertex::get_neighbour(quint32 edgeIndex)
 {
-    Vertex * neighbour = 0;
-    Edge * edge = myEdge.at(edge_index);
-    if (edge->fromVertex() == this)
-        neighbour = edge->toVertex();
-    else
-        neighbour = edge->fromVertex();
-    return neighbour;
+    return myGraph->getVertex(topology()->getNeighbour(myIndex, edgeIndex));
 }
 
-Vertex *Vertex::get_neighbour_fromEdge(Edge *edge)
+Vertex *Vertex::get_neighbour_fromEdge(quint32 e)
 {
     Vertex * neighbour = 0;
-    if (edge->toVertex() == this || edge->fromVertex() == this)
-    {
-        if (edge->fromVertex() == this)
-            neighbour = edge->toVertex();
-        else
-            neighbour = edge->fromVertex();
-    }
+    if (edgeTable()->hasEndpoint(e, myIndex))
+        neighbour = myGraph->getVertex(edgeTable()->getOther(e, myIndex));
     else
         qDebug() << "ERROR: EITHER END OF THE EDGE IS NOT THE QUERIED VERTEX!";
     return neighbour;
 }
 
-Edge *Vertex::getHighestDegreeNeighbour()
+quint32 Vertex::getHighestDegreeNeighbour()
 {
-    QList<Edge*> edge;
-    Edge * final;
+    QList<quint32> edge;
     quint32 highest = 0;
-    for (int i = 0; i < myEdge.size(); i++)
+    const CSRGraph * g = topology();
+    const quint32 * adj = g->neighbours(myIndex);
+    quint32 deg = getNumberEdge();
+    for (quint32 i = 0; i < deg; i++)
     {
-        Edge * e = myEdge.at(i);
-        Vertex * v = get_neighbour_fromEdge(e);
-        quint32 d = v->getNumberEdge();
+        quint32 d = g->getDegree(adj[i]);
         if (d > highest)
         {
             highest = d;
             edge.clear();
-            edge.append(e);
+            edge.append(i);
         }
         else if (d == highest)
         {
-            edge.append(e);
+            edge.append(i);
         }
     }
     if (edge.size() > 1)
     {
-        std::uniform_int_distribution<int> distribution(0,edge.size()-1);
-        int ran = distribution(gen);
-        final = edge.at(ran);
+        quint32 ran = myGraph->getGenerator().bounded(edge.size());
+        return getEdge(edge.at(ran));
     }
     else
-        final = edge.at(0);
-    return final;
-}
-
-QList<Edge *> Vertex::getAllEdge() const
-{
-    return myEdge;
-}
-
-Edge *Vertex::getEdge(quint32 edgeIndex) const
-{
-    return myEdge.at(edgeIndex);
+        return getEdge(edge.at(0));
 }
 
-/**  Return a neigbour vertex which was selected with uniform selectiong with a given bias to one's weight
- * @brief Vertex::getWeightedProbabilisticEdge
- * @return
- */
-Edge *Vertex::getWeightedProbabilisticEdge()
+QList<quint32> Vertex::getAllEdge() const
 {
-    QList<Edge*> edge;
-    for (int i = 0; i < myEdge.size(); i++)
-    {
-        Edge * e = myEdge.at(i);
-        Vertex * v = get_neighbour_fromEdge(e);
-        quint64 w = v->getWeight();
-        for (quint64 j = 0; j < w; j++)
-            edge.append(e);
-    }
-    std::uniform_int_distribution<quint64> distribution(0,edge.size()-1);
-    quint64 ran = distribution(gen);
-    return edge.at(ran);
+    QList<quint32> edge;
+    const quint32 * eid = topology()->edges(myIndex);
+    quint32 d = getNumberEdge();
+    edge.reserve(d);
+    for (quint32 i = 0; i < d; i++)
+        edge.append(eid[i]);
+    return edge;
 }
 
-/** Get Edege with Pr(e) = d(e)/sum d
- * @brief Vertex::getDegreeProbabilisticEdge
- * @return
- */
-Edge *Vertex::getDegreeProbabilisticEdge()
+quint32 Vertex::getEdge(quint32 edgeIndex) const
 {
-    QList<Edge*> edge;
-    for (int i = 0; i < myEdge.size(); i++)
-    {
-        Edge * e = myEdge.at(i);
-        Vertex * v = get_neighbour_fromEdge(e);
-        quint32 w = v->getNumberEdge();
-        for (quint32 j = 0; j < w; j++)
-            edge.append(e);
-    }
-
-    std::uniform_int_distribution<quint32> distribution(0,edge.size()-1);
-    quint32 ran = distribution(gen);
-    return edge.at(ran);
+    return topology()->getEdge(myIndex, edgeIndex);
 }
 
-
-/** For aggregate with degree bias:
- * Return a neigbour vertex which was selected with uniform selectiong with a given bias to one's weight
- * @brief Vertex::aggregate_get_degree_biased_neighbour
- * @return
- */
-Vertex *Vertex::aggregate_get_degree_biased_neighbour()
-{
-    QList<Vertex*> neighbours;
-    for (int i = 0; i < myEdge.size(); i++)
-    {
-        Vertex * neighbour = this->get_neighbour_fromEdge(myEdge[i]);
-        quint64 weight = neighbour->getWeight();
-        for (quint64 j = 0; j < weight; j++)
-            neighbours.append(neighbour);
-    }
-    std::uniform_int_distribution<quint64> distribution(0,neighbours.size()-1);
-    quint64 ran = distribution(gen);
-    return neighbours.at(ran);
-}
-
-
 void Vertex::set_vertex_as_absorbed(bool val)
 {
     isAbsorbed = val;
@@ -523,36 +388,34 @@ bool Vertex::is_vertex_dragged_along() const
 /** GET THE NEIGHBOUR VERTEX THAT HAS THE HIGHEST NUMBER OF MUTUAL TRIANGULATION
  * @brief Vertex::getMostMutualVertex
  */
-Edge * Vertex::getMostMutualVertex()
+quint32 Vertex::getMostMutualVertex()
 {
-    QList<Edge*> ran_list;
+    QList<quint32> ran_list;
     quint32 highest = 0;
-    for (int i = 0; i < myEdge.size(); i++)
+    quint32 d = getNumberEdge();
+    for (quint32 i = 0; i < d; i++)
     {
-        Vertex * neighbour = this->get_neighbour_fromEdge(myEdge[i]);
-        quint64 similar = this->getNoOfTriangles(neighbour);
+        quint64 similar = getNoOfTrianglesOnEdge(i);
         if (similar > highest)
         {
             highest = similar;
             ran_list.clear();
-            ran_list.append(myEdge[i]);
+            ran_list.append(getEdge(i));
         }
         else if (similar == highest)
         {
-            ran_list.append(myEdge[i]);
+            ran_list.append(getEdge(i));
         }
     }
     if (ran_list.size() == 0)
     {
-        std::uniform_int_distribution<int> distribution(0,myEdge.size()-1);
-        int ran = distribution(gen);
-        return myEdge.at(ran);
+        quint32 ran = myGraph->getGenerator().bounded(d);
+        return getEdge(ran);
     }
     else if (ran_list.size() > 1)
     {
-        std::uniform_int_distribution<int> distribution(0,ran_list.size()-1);
-        int ran = distribution(gen);
-        return myEdge.at(ran);
+        quint32 ran = myGraph->getGenerator().bounded(ran_list.size());
+        return getEdge(ran);
     }
     else
         return ran_list[0];
@@ -561,39 +424,51 @@ Edge * Vertex::getMostMutualVertex()
 
 
 /** Get the Highest Triangulate Cluster
+ * Every cluster next to this vertex is scored once, through the first edge
+ * that reaches it: the triangles on that edge, plus the other neighbours of
+ * this vertex inside the cluster, the root of the cluster not included.
+ * If this vertex is itself the root of the cluster, size - 1 is taken off.
+ * Example: v is adjacent to r, a, b and x, {r, a, b} is one cluster with
+ * root r and x is alone. If (v, r) is the first edge into the cluster, the
+ * cluster scores tri(v, r) + 2 (a and b); if (v, a) comes first, it scores
+ * tri(v, a) + 1 (b only, r is the root). x scores tri(v, x).
  * @brief Vertex::getHighestTriangulateCluster
  * @return
  */
 
-Edge *Vertex::getHighestTriangulateCluster()
+quint32 Vertex::getHighestTriangulateCluster()
 {
-    //first get all neighbour cluster
-    QList<Vertex*> centroids;
+    //first get all neighbour cluster, with how many non root neighbours each holds
+    UnionFind * clusters = myGraph->getClusters();
+    QList<quint32> centroids;
     QList<quint32> queried_edge;
-    for (quint32 i = 0; i < myEdge.size(); i++)
+    QHash<quint32, quint32> members_in_cluster;
+    const quint32 * myNeighbours = topology()->neighbours(myIndex);
+    quint32 d = getNumberEdge();
+    bool seen_self = false;
+    members_in_cluster.reserve(d);
+    for (quint32 i = 0; i < d; i++)
     {
-        Edge * e = myEdge.at(i);
-        Vertex * neighbour = this->get_neighbour_fromEdge(e);
-        //get the neighbour cluster
-        Vertex * par = neighbour->getParent();
-        QList<Vertex*> tree;
-        while (par != 0)
+        //a self loop holds this vertex twice, it is one neighbour
+        quint32 adj = myNeighbours[i];
+        if (adj == myIndex)
         {
-            neighbour = par;
-            if (tree.contains(neighbour))
-                break;
-            else
-                tree.append(neighbour);
-            par = neighbour->getParent();
+            if (seen_self)
+                continue;
+            seen_self = true;
         }
-        if (centroids.contains(neighbour))
-            continue;
+        //get the neighbour cluster
+        quint32 root = clusters->find(adj);
+        quint32 member = (adj != root) ? 1 : 0;
+        QHash<quint32, quint32>::iterator it = members_in_cluster.find(root);
+        if (it != members_in_cluster.end())
+            it.value() += member;
         else
         {
-                centroids.append(neighbour);
-                queried_edge.append(i);
+            members_in_cluster.insert(root, member);
+            centroids.append(root);
+            queried_edge.append(i);
         }
-
     }
 
     quint64 highest_score = 0;
@@ -602,41 +477,18 @@ Edge *Vertex::getHighestTriangulateCluster()
     for (quint32 i = 0 ; i < queried_edge.size(); i++)
     {
         quint32 edge_index = queried_edge.at(i);
-        Edge * e = myEdge.at(edge_index);
-        Vertex * adjacent = this->get_neighbour_fromEdge(e);
+        quint32 adjacent = myNeighbours[edge_index];
 
-        Vertex * queried_centroid = centroids[i];
-        quint32 score = 0;
+        quint32 queried_centroid = centroids[i];
         // count number of real triangles between V and This
-        QList<quint32> current_iteration_neighbour = adjacent->getNeighbourIndexes();
-        //get current centroid indexes
-        QList<Vertex*> current_iteration_cluster = queried_centroid->getMyCluster();
-        QList<quint32> current_iteration_cluster_indexes;
-        for (quint32 j = 0; j < current_iteration_cluster.size(); j++ )
-        {
-            Vertex * v = current_iteration_cluster.at(j);
-            current_iteration_cluster_indexes.append(v->getIndex());
-
-        }
-
-        //counting score
-        for (quint32 j = 0; j < myNeighbours.size(); j++)
-        {
-            quint32 adj = myNeighbours[j];
-            if (adj == adjacent->getIndex())
-                continue;
-            if (current_iteration_neighbour.contains(adj))
-            {
-                score++;
-            }
-            if (current_iteration_cluster_indexes.contains(adj))
-            {
-                score++;
-            }
-        }
-
-        if (queried_centroid->getIndex() == this->getIndex())
-            score -= myCluster.size();
+        quint32 score = getNoOfTrianglesOnEdge(edge_index);
+        //plus the other neighbours of This in the cluster, the adjacent one excluded
+        score += members_in_cluster.value(queried_centroid);
+        if (adjacent != queried_centroid)
+            score--;
+
+        if (queried_centroid == myIndex)
+            score -= clusters->getSize(myIndex) - 1;
         if (score < highest_score)
         {
             if (index.size() == 0)
@@ -661,8 +513,7 @@ Edge *Vertex::getHighestTriangulateCluster()
     quint32 selected_index = 0;
     if (index.size() > 1)
     {
-        std::uniform_int_distribution<int> distribution(0,index.size()-1);
-        int ran = distribution(gen);
+        quint32 ran = myGraph->getGenerator().bounded(index.size());
         selected_index = index.at(ran);
     }
     else
@@ -670,7 +521,7 @@ Edge *Vertex::getHighestTriangulateCluster()
         selected_index = index.at(0);
     }
 
-    Edge * final = myEdge.at(selected_index);
+    quint32 final = getEdge(selected_index);
     return final;
 }
 
@@ -681,29 +532,28 @@ Edge *Vertex::getHighestTriangulateCluster()
  * @return selected Edge
  */
 
-Edge *Vertex::getProbabilisticTriangulationCoeffVertex()
+quint32 Vertex::getProbabilisticTriangulationCoeffVertex()
 {
-    QList<Edge*> sample;
-    for (quint32 i = 0; i < myEdge.size(); i++)
+    QList<quint32> sample;
+    quint32 d = getNumberEdge();
+    for (quint32 i = 0; i < d; i++)
     {
-        Vertex * neighbour = this->get_neighbour_fromEdge(myEdge[i]);
-        quint32 similar = this->getNoOfTriangles(neighbour);
+        quint32 similar = getNoOfTrianglesOnEdge(i);
+        quint32 e = getEdge(i);
 
-        sample.append(myEdge[i]);
+        sample.append(e);
         for (quint32 j =0; j < similar; j++)
-            sample.append(myEdge[i]);
+            sample.append(e);
     }
     if(!sample.empty())
     {
-        std::uniform_int_distribution<quint32> distribution(0,sample.size()-1);
-        quint32 ran = distribution(gen);
+        quint32 ran = myGraph->getGenerator().bounded(sample.size());
         return sample.at(ran);
     }
     else
     {
-        std::uniform_int_distribution<int> distribution(0,myEdge.size()-1);
-        int ran = distribution(gen);
-        return myEdge.at(ran);
+        quint32 ran = myGraph->getGenerator().bounded(d);
+        return getEdge(ran);
     }
 }
 
@@ -714,82 +564,56 @@ Edge *Vertex::getProbabilisticTriangulationCoeffVertex()
  * @brief Vertex::getProbabilisticTriangulationAndWeightVertex
  * @return the selected vertex
  */
-Edge *Vertex::getProbabilisticTriangulationAndWeightVertex()
+quint32 Vertex::getProbabilisticTriangulationAndWeightVertex()
 {
-    QList<Edge*> sample;
-    if (this->getNumberEdge() == 1)
-        return myEdge.at(0);
+    QList<quint32> sample;
+    quint32 d = this->getNumberEdge();
+    if (d == 1)
+        return getEdge(0);
 
-    for (int i = 0; i < myEdge.size(); i++)
+    for (quint32 i = 0; i < d; i++)
     {
-        Vertex * neighbour = this->get_neighbour_fromEdge(myEdge[i]);
-        quint32 similar = this->getNoOfTriangles(neighbour);
+        Vertex * neighbour = this->get_neighbour(i);
+        quint32 e = getEdge(i);
+        quint32 similar = getNoOfTrianglesOnEdge(i);
         quint64 normalise_w = 0;
         if (neighbour->getNoChild() > 0)
             normalise_w = neighbour->getExtraWeight() / neighbour->getNoChild();
         quint64 new_w = (similar*2) * (neighbour->getWeight() + normalise_w);
         for (quint64 j =0; j < new_w; j++)
-            sample.append(myEdge[i]);
+            sample.append(e);
     }
     if (sample.size() == 0)
-        return 0;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    gen.seed(QTime::currentTime().msec());
-    std::uniform_int_distribution<quint64> distribution(0, sample.size() - 1);
-    quint64 ran = distribution(gen);
+        return EdgeTable::NoEdge;
+    quint32 ran = myGraph->getGenerator().bounded(sample.size());
     return sample.at(ran);
 }
 
 
 
+/** Number of common neighbours, intersected on the sorted adjacency
+ * @brief Vertex::getNoOfTriangles
+ * @param v
+ */
 quint32 Vertex::getNoOfTriangles(Vertex *v)
 {
-    QSet<quint32> thisAdj = this->getNeighbourIndexes().toSet();
-    QSet<quint32> neighbourAdj = v->getNeighbourIndexes().toSet();
-    quint32 similar = thisAdj.intersect(neighbourAdj).size();
-    return similar;
+    return topology()->countCommonNeighbours(myIndex, v->getIndex());
 }
 
-
-QList<Vertex *> Vertex::getMyCluster()
-{
-    return myCluster;
-}
-
-
-void Vertex::addMemberToCluster(Vertex *v)
-{
-    if (myCluster.contains(v))
-        qDebug() << "ERR: MEMBER ALREADY IN CLUSTER";
-    else
-        myCluster.append(v);
-}
-
-
-void Vertex::addMemberToCluster(QList<Vertex *> v)
-{
-    if (v.size() == 0)
-        return;
-    for (quint32 i = 0; i < v.size(); i++)
-    {
-        if (!myCluster.contains(v[i]))
-            myCluster.append(v[i]);
-    }
-}
-
-
-void Vertex::clearCluster()
+/** Triangles through the edgeIndex-th live edge of this vertex
+ * Read from the graph cache while the run tracks it, counted otherwise
+ * @brief Vertex::getNoOfTrianglesOnEdge
+ * @param edgeIndex
+ */
+quint32 Vertex::getNoOfTrianglesOnEdge(const quint32 &edgeIndex)
 {
-    myCluster.clear();
+    TriangleSupport * triangles = myGraph->getTriangles();
+    if (triangles->isTracking())
+        return triangles->get(getEdge(edgeIndex));
+    return getNoOfTriangles(get_neighbour(edgeIndex));
 }
 
 
-void Vertex::clearAbsorbed()
-{
-    absorbed.clear();
-}
-
 void Vertex::setTruthCommunity(const int &p)
 {
     myRealCommunity = p;
@@ -805,14 +629,10 @@ int Vertex::getTruthCommunity() const
 
 void Vertex::resetClusterRelevant()
 {
-    myCluster.clear();
-    absorbed.clear();
     myWeight = 1;
     parent = 0;
     isDraggedAlong = false;
     isAbsorbed = false;
     noOfChild = 0;
     ExtraWeight = 0;
-    myNeighbours.clear();
-    myEdge.clear();
 }
@@ -4,55 +4,48 @@
 #include <QSet>
 #include <QDebug>
 
-#include "edge.h"
+class Graph;
+class CSRGraph;
+class EdgeTable;
 
 class Vertex
 {
 public:
-    Vertex();
+    Vertex(Graph * graph);
     ~Vertex();
     void setIndex(const quint32 &number);
     quint32 getIndex() const;
 
-    void addAdj(const quint32 &index);
     quint32 getNumAdj() const;
 
     quint32 getOneNeighbourIndex(const quint32 &index);
-    void removeAdj(const quint32 &index);
-    void removeAll();
 
     void setWeight(const quint64 &w);
     void setWeightAsNumberOfAbsorbed();
     quint64 getWeight() const;
 
-    void addEdge(Edge *edge);
-    void removeEdge(Edge *edge);
     quint32 getNumberEdge() const;
     void remove_all_edges();
 
-    void absorb_removeEdge(quint32 edge_index);
-    void absorb_removeEdge(Edge * e);
-    void absorb_removeVertex_retainEdge(Edge * e);
-    void absorb_retainEdge(Edge * e);
-    void absorb_retainEdge_setParentPointer(Edge * e);
+    void absorb_removeEdge(quint32 e);
+    void absorb_removeVertex_retainEdge(quint32 e);
+    void absorb_retainEdge(quint32 e);
+    void absorb_retainEdge_setParentPointer(quint32 e);
     void absorb_singleton(Vertex * v);
 
-    Edge * getEdge(quint32 edgeIndex) const;
-    Edge * getWeightedProbabilisticEdge();
-    Edge * getDegreeProbabilisticEdge();
-    Edge * getEdgeFromVertex(Vertex * v2);
-    Edge * getSmallestCurrentDegreeNeighbour();
-    Edge * getSmallestCurrentWeightNeighbour();
-    Edge * getHighestDegreeNeighbour();
-    Edge * getMostMutualVertex();
-    Edge * getHighestTriangulateCluster();
-    Edge * getProbabilisticTriangulationCoeffVertex();
-    Edge * getProbabilisticTriangulationAndWeightVertex();
-    QList<Edge*> getAllEdge() const;
+    quint32 getEdge(quint32 edgeIndex) const;
+    quint32 getEdgeFromVertex(Vertex * v2);
+    quint32 getSmallestCurrentDegreeNeighbour();
+    quint32 getSmallestCurrentWeightNeighbour();
+    quint32 getHighestDegreeNeighbour();
+    quint32 getMostMutualVertex();
+    quint32 getHighestTriangulateCluster();
+    quint32 getProbabilisticTriangulationCoeffVertex();
+    quint32 getProbabilisticTriangulationAndWeightVertex();
+    QList<quint32> getAllEdge() const;
 
-    Vertex * aggregate_get_degree_biased_neighbour();
-    Vertex *get_neighbour_fromEdge(quint32 edge_index);
-    Vertex *get_neighbour_fromEdge(Edge * e);
+    Vertex *get_neighbour(quint32 edgeIndex);
+    Vertex *get_neighbour_fromEdge(quint32 e);
 
 
     void setParent(Vertex * v);
@@ -64,7 +57,6 @@ public:
     quint64 getExtraWeight() const;
     quint32 getNoChild() const;
 
-    QList<Vertex*> getAbsorbedList();
     QList<quint32> getNeighbourIndexes();
 
     void set_vertex_as_absorbed(bool val);
@@ -72,11 +64,7 @@ public:
     bool is_vertex_dragged_along() const;
 
     quint32 getNoOfTriangles(Vertex * v);
-    QList<Vertex*> getMyCluster();
-    void addMemberToCluster(Vertex * v);
-    void addMemberToCluster(QList<Vertex*> v);
-    void clearCluster();
-    void clearAbsorbed();
+    quint32 getNoOfTrianglesOnEdge(const quint32 &edgeIndex);
 
     void setTruthCommunity(const int &p);
     int getTruthCommunity() const;
@@ -84,15 +72,13 @@ public:
     void resetClusterRelevant();
 
 private:
+    CSRGraph * topology() const;
+    EdgeTable * edgeTable() const;
 
+    Graph * myGraph;
     Vertex * parent;
-    QList<quint32> myNeighbours;
-    QList<Vertex*> absorbed;
 
 protected:
-    QList<Edge *> myEdge;
-    QList<Vertex*> myCluster;
-
     quint32 myIndex;
     quint64 myWeight;
     bool isDraggedAlong;